@@ -3358,6 +3358,732 @@ JSVM_EXTERN JSVM_Status OH_JSVM_CreateArrayBufferFromExternalMemory(JSVM_Env env
                                                                     void* finalizeHint,
                                                                     bool* copied,
                                                                     JSVM_Value* result);
+
+/**
+ * @brief This API creates a function object in native code that JavaScript code can call. Besides the
+ * regular callback, the function carries a C function with a declared signature which optimized
+ * JavaScript code may call directly, skipping argument conversion to JSVM_Value. The regular callback
+ * is used whenever the fast path is not possible. The created function can not be used as a constructor.
+ *
+ * @param env The environment that the API is invoked under.
+ * @param utf8name Name of the function encoded as UTF8 string.
+ * @param length The length of the utf8name in bytes, or JSVM_AUTO_LENGTH if it is null-terminated.
+ * @param cb The regular callback and the fast call signature. The regular callback must stay valid
+ *           as long as the function is alive.
+ * @param result JSVM_Value representing the JavaScript function object.
+ * @return Returns JSVM funtions result code.
+ *         {@link JSVM_OK } if the function executed successfully.\n
+ *         {@link JSVM_INVALID_ARG } if cb or result is NULL, the fast callback is NULL, or the signature
+ *         is invalid.\n
+ *         {@link JSVM_GENERIC_FAILURE } if the function can not be created.\n
+ * @since 26
+ */
+JSVM_EXTERN JSVM_Status OH_JSVM_CreateFunctionWithFastCall(JSVM_Env env,
+                                                           const char* utf8name,
+                                                           size_t length,
+                                                           JSVM_FastCallback cb,
+                                                           JSVM_Value* result);
+
+/**
+ * @brief This API decodes the arguments of a callback according to the expected types in one call, instead
+ * of one OH_JSVM_GetValue* call per argument. Number conversions follow OH_JSVM_GetValueInt32,
+ * OH_JSVM_GetValueUint32, OH_JSVM_GetValueInt64 and OH_JSVM_GetValueDouble, and strings are copied
+ * like OH_JSVM_GetValueStringUtf8.
+ *
+ * @param env The environment that the API is invoked under.
+ * @param cbinfo The callback info passed into the callback function.
+ * @param argc Number of entries in specs, at most 64. Argument i is decoded by specs[i].
+ * @param specs Expected type and destination of each argument.
+ * @param mismatch Bit i is set if argument i is missing or does not have the expected type,
+ *                 its destination is left untouched in that case.
+ * @return Returns JSVM funtions result code.
+ *         {@link JSVM_OK } if the function executed successfully.\n
+ *         {@link JSVM_INVALID_ARG } if cbinfo, specs or mismatch is NULL, argc is greater than 64,
+ *         or a destination in specs is NULL.\n
+ * @since 26
+ */
+JSVM_EXTERN JSVM_Status OH_JSVM_GetCbTypedArgs(JSVM_Env env,
+                                               JSVM_CallbackInfo cbinfo,
+                                               size_t argc,
+                                               const JSVM_ArgSpec* specs,
+                                               uint64_t* mismatch);
+
+/**
+ * @brief This API calls the same JavaScript function callCount times within one API call. Call i receives
+ * the argc arguments starting at argv[i * argc]. It stops at the first call that throws, the exception is
+ * left pending like OH_JSVM_CallFunction.
+ *
+ * @param env The environment that the API is invoked under.
+ * @param recv The this value passed to every call.
+ * @param func JSVM_Value representing the JavaScript function to be invoked.
+ * @param callCount Number of calls.
+ * @param argc Number of arguments of each call.
+ * @param argv Flat array of callCount * argc JSVM_Values.
+ * @param results Optional. Array of callCount JSVM_Values receiving the return value of each call.
+ * @param failedIndex Optional. Receives the index of the call which threw, or callCount if none threw.
+ * @return Returns JSVM funtions result code.
+ *         {@link JSVM_OK } if the function executed successfully.\n
+ *         {@link JSVM_INVALID_ARG } if recv or func is NULL, func is not a function, or argv is NULL
+ *         while callCount and argc are not zero.\n
+ *         {@link JSVM_PENDING_EXCEPTION } if one of the calls threw.\n
+ *         {@link JSVM_GENERIC_FAILURE } if a call returned no value without throwing.\n
+ * @since 26
+ */
+JSVM_EXTERN JSVM_Status OH_JSVM_CallFunctionBatch(JSVM_Env env,
+                                                  JSVM_Value recv,
+                                                  JSVM_Value func,
+                                                  size_t callCount,
+                                                  size_t argc,
+                                                  const JSVM_Value* argv,
+                                                  JSVM_Value* results,
+                                                  size_t* failedIndex);
+
+/**
+ * @brief This API prepares repeated calls of a JavaScript function. The function, the this value and the
+ * number of arguments are validated and retained once, so OH_JSVM_InvokePrepared does not check them again.
+ * The prepared call must be released with OH_JSVM_ReleasePrepared before the env is destroyed.
+ *
+ * @param env The environment that the API is invoked under.
+ * @param func JSVM_Value representing the JavaScript function to be invoked.
+ * @param recv Optional. The this value passed to the function, undefined if NULL.
+ * @param argc Number of arguments of each call.
+ * @param result The prepared call.
+ * @return Returns JSVM funtions result code.
+ *         {@link JSVM_OK } if the function executed successfully.\n
+ *         {@link JSVM_INVALID_ARG } if func or result is NULL, func is not a function,
+ *         or argc is greater than INT_MAX.\n
+ * @since 26
+ */
+JSVM_EXTERN JSVM_Status OH_JSVM_PrepareCall(JSVM_Env env,
+                                            JSVM_Value func,
+                                            JSVM_Value recv,
+                                            size_t argc,
+                                            JSVM_PreparedCall* result);
+
+/**
+ * @brief This API invokes a call prepared by OH_JSVM_PrepareCall.
+ *
+ * @param env The environment that the API is invoked under.
+ * @param call The prepared call.
+ * @param argv Array of the number of JSVM_Values given to OH_JSVM_PrepareCall.
+ * @param result Optional. JSVM_Value representing the return value of the function.
+ * @return Returns JSVM funtions result code.
+ *         {@link JSVM_OK } if the function executed successfully.\n
+ *         {@link JSVM_INVALID_ARG } if call is NULL, or argv is NULL while the prepared call takes arguments.\n
+ *         {@link JSVM_PENDING_EXCEPTION } if the function threw.\n
+ *         {@link JSVM_GENERIC_FAILURE } if the function returned no value without throwing.\n
+ * @since 26
+ */
+JSVM_EXTERN JSVM_Status OH_JSVM_InvokePrepared(JSVM_Env env,
+                                               JSVM_PreparedCall call,
+                                               const JSVM_Value* argv,
+                                               JSVM_Value* result);
+
+/**
+ * @brief This API releases a call prepared by OH_JSVM_PrepareCall.
+ *
+ * @param env The environment that the API is invoked under.
+ * @param call The prepared call to be released.
+ * @return Returns JSVM funtions result code.
+ *         {@link JSVM_OK } if the function executed successfully.\n
+ *         {@link JSVM_INVALID_ARG } if call is NULL.\n
+ * @since 26
+ */
+JSVM_EXTERN JSVM_Status OH_JSVM_ReleasePrepared(JSVM_Env env, JSVM_PreparedCall call);
+
+/**
+ * @brief This API gets several properties of an object within one API call, result i is the value of
+ * property keys[i]. Keys created once, such as internalized strings kept in references, can be reused
+ * across calls. It stops at the first property that fails.
+ *
+ * @param env The environment that the API is invoked under.
+ * @param object The object from which to retrieve the properties.
+ * @param count Number of properties.
+ * @param keys Array of count JSVM_Values, the names of the properties.
+ * @param results Array of count JSVM_Values receiving the values of the properties.
+ * @return Returns JSVM funtions result code.
+ *         {@link JSVM_OK } if the function executed successfully.\n
+ *         {@link JSVM_INVALID_ARG } if keys or results is NULL while count is not zero, or one of the keys is NULL.\n
+ *         {@link JSVM_OBJECT_EXPECTED } if object is not an object.\n
+ *         {@link JSVM_PENDING_EXCEPTION } if a getter threw.\n
+ *         {@link JSVM_GENERIC_FAILURE } if a property can not be retrieved.\n
+ * @since 26
+ */
+JSVM_EXTERN JSVM_Status OH_JSVM_GetProperties(JSVM_Env env,
+                                              JSVM_Value object,
+                                              size_t count,
+                                              const JSVM_Value* keys,
+                                              JSVM_Value* results);
+
+/**
+ * @brief This API sets several properties of an object within one API call, property keys[i] is set to
+ * values[i]. It stops at the first property that fails.
+ *
+ * @param env The environment that the API is invoked under.
+ * @param object The object on which to set the properties.
+ * @param count Number of properties.
+ * @param keys Array of count JSVM_Values, the names of the properties.
+ * @param values Array of count JSVM_Values, the values of the properties.
+ * @return Returns JSVM funtions result code.
+ *         {@link JSVM_OK } if the function executed successfully.\n
+ *         {@link JSVM_INVALID_ARG } if keys or values is NULL while count is not zero, or one of their
+ *         elements is NULL.\n
+ *         {@link JSVM_OBJECT_EXPECTED } if object is not an object.\n
+ *         {@link JSVM_PENDING_EXCEPTION } if a setter threw.\n
+ *         {@link JSVM_GENERIC_FAILURE } if a property can not be set.\n
+ * @since 26
+ */
+JSVM_EXTERN JSVM_Status OH_JSVM_SetProperties(JSVM_Env env,
+                                              JSVM_Value object,
+                                              size_t count,
+                                              const JSVM_Value* keys,
+                                              const JSVM_Value* values);
+
+/**
+ * @brief This API creates a property key from a UTF8 name. The name is internalized once and retained, so
+ * named property access through the key neither allocates nor hashes the name again. The key must be
+ * released with OH_JSVM_ReleasePropertyKey before the env is destroyed.
+ *
+ * @param env The environment that the API is invoked under.
+ * @param utf8name Name of the property encoded as UTF8 string.
+ * @param length The length of the utf8name in bytes, or JSVM_AUTO_LENGTH if it is null-terminated.
+ * @param result The created property key.
+ * @return Returns JSVM funtions result code.
+ *         {@link JSVM_OK } if the function executed successfully.\n
+ *         {@link JSVM_INVALID_ARG } if utf8name or result is NULL, or length is greater than INT_MAX.\n
+ *         {@link JSVM_GENERIC_FAILURE } if the name can not be created.\n
+ * @since 26
+ */
+JSVM_EXTERN JSVM_Status OH_JSVM_CreatePropertyKey(JSVM_Env env,
+                                                  const char* utf8name,
+                                                  size_t length,
+                                                  JSVM_PropertyKey* result);
+
+/**
+ * @brief This API releases a property key created by OH_JSVM_CreatePropertyKey.
+ *
+ * @param env The environment that the API is invoked under.
+ * @param key The property key to be released.
+ * @return Returns JSVM funtions result code.
+ *         {@link JSVM_OK } if the function executed successfully.\n
+ *         {@link JSVM_INVALID_ARG } if key is NULL.\n
+ * @since 26
+ */
+JSVM_EXTERN JSVM_Status OH_JSVM_ReleasePropertyKey(JSVM_Env env, JSVM_PropertyKey key);
+
+/**
+ * @brief This API returns the name of a property key as JavaScript string, e.g. to be used as key of
+ * OH_JSVM_GetProperties and OH_JSVM_SetProperties.
+ *
+ * @param env The environment that the API is invoked under.
+ * @param key The property key.
+ * @param result JSVM_Value representing the name of the property.
+ * @return Returns JSVM funtions result code.
+ *         {@link JSVM_OK } if the function executed successfully.\n
+ *         {@link JSVM_INVALID_ARG } if key or result is NULL.\n
+ * @since 26
+ */
+JSVM_EXTERN JSVM_Status OH_JSVM_GetPropertyKeyValue(JSVM_Env env, JSVM_PropertyKey key, JSVM_Value* result);
+
+/**
+ * @brief This API is equivalent to OH_JSVM_SetNamedProperty with the name given by a property key.
+ *
+ * @param env The environment that the API is invoked under.
+ * @param object The object on which to set the property.
+ * @param key The name of the property.
+ * @param value The property value.
+ * @return Returns JSVM funtions result code.
+ *         {@link JSVM_OK } if the function executed successfully.\n
+ *         {@link JSVM_INVALID_ARG } if key or value is NULL.\n
+ *         {@link JSVM_OBJECT_EXPECTED } if object is not an object.\n
+ *         {@link JSVM_PENDING_EXCEPTION } if a setter threw.\n
+ *         {@link JSVM_GENERIC_FAILURE } if the property can not be set.\n
+ * @since 26
+ */
+JSVM_EXTERN JSVM_Status OH_JSVM_SetNamedPropertyByKey(JSVM_Env env,
+                                                      JSVM_Value object,
+                                                      JSVM_PropertyKey key,
+                                                      JSVM_Value value);
+
+/**
+ * @brief This API is equivalent to OH_JSVM_GetNamedProperty with the name given by a property key.
+ *
+ * @param env The environment that the API is invoked under.
+ * @param object The object from which to retrieve the property.
+ * @param key The name of the property.
+ * @param result The value of the property.
+ * @return Returns JSVM funtions result code.
+ *         {@link JSVM_OK } if the function executed successfully.\n
+ *         {@link JSVM_INVALID_ARG } if key or result is NULL.\n
+ *         {@link JSVM_OBJECT_EXPECTED } if object is not an object.\n
+ *         {@link JSVM_PENDING_EXCEPTION } if a getter threw.\n
+ *         {@link JSVM_GENERIC_FAILURE } if the property can not be retrieved.\n
+ * @since 26
+ */
+JSVM_EXTERN JSVM_Status OH_JSVM_GetNamedPropertyByKey(JSVM_Env env,
+                                                      JSVM_Value object,
+                                                      JSVM_PropertyKey key,
+                                                      JSVM_Value* result);
+
+/**
+ * @brief This API is equivalent to OH_JSVM_HasNamedProperty with the name given by a property key.
+ *
+ * @param env The environment that the API is invoked under.
+ * @param object The object to query.
+ * @param key The name of the property.
+ * @param result Whether the property exists on the object or not.
+ * @return Returns JSVM funtions result code.
+ *         {@link JSVM_OK } if the function executed successfully.\n
+ *         {@link JSVM_INVALID_ARG } if key or result is NULL.\n
+ *         {@link JSVM_OBJECT_EXPECTED } if object is not an object.\n
+ *         {@link JSVM_PENDING_EXCEPTION } if a proxy trap threw.\n
+ *         {@link JSVM_GENERIC_FAILURE } if the query failed.\n
+ * @since 26
+ */
+JSVM_EXTERN JSVM_Status OH_JSVM_HasNamedPropertyByKey(JSVM_Env env,
+                                                      JSVM_Value object,
+                                                      JSVM_PropertyKey key,
+                                                      bool* result);
+
+/**
+ * @brief This API creates the layout of a C struct, used to convert between the struct and a JavaScript
+ * object with one property per field. Objects created with the same layout share their hidden class.
+ * The layout must be released with OH_JSVM_ReleaseStructLayout before the env is destroyed, and nested
+ * layouts must outlive the layouts which refer to them.
+ *
+ * @param env The environment that the API is invoked under.
+ * @param fieldCount Number of fields.
+ * @param fields Array of fieldCount field descriptions.
+ * @param result The created struct layout.
+ * @return Returns JSVM funtions result code.
+ *         {@link JSVM_OK } if the function executed successfully.\n
+ *         {@link JSVM_INVALID_ARG } if result is NULL, fields is NULL while fieldCount is not zero, a field has
+ *         no name, an invalid type, or no nested layout for JSVM_FIELD_STRUCT.\n
+ * @since 26
+ */
+JSVM_EXTERN JSVM_Status OH_JSVM_CreateStructLayout(JSVM_Env env,
+                                                   size_t fieldCount,
+                                                   const JSVM_StructField* fields,
+                                                   JSVM_StructLayout* result);
+
+/**
+ * @brief This API releases a struct layout created by OH_JSVM_CreateStructLayout.
+ *
+ * @param env The environment that the API is invoked under.
+ * @param layout The struct layout to be released.
+ * @return Returns JSVM funtions result code.
+ *         {@link JSVM_OK } if the function executed successfully.\n
+ *         {@link JSVM_INVALID_ARG } if layout is NULL.\n
+ * @since 26
+ */
+JSVM_EXTERN JSVM_Status OH_JSVM_ReleaseStructLayout(JSVM_Env env, JSVM_StructLayout layout);
+
+/**
+ * @brief This API converts a C struct to a new JavaScript object according to a struct layout.
+ *
+ * @param env The environment that the API is invoked under.
+ * @param layout The layout of the struct.
+ * @param data Pointer to the struct.
+ * @param result JSVM_Value representing the created object.
+ * @return Returns JSVM funtions result code.
+ *         {@link JSVM_OK } if the function executed successfully.\n
+ *         {@link JSVM_INVALID_ARG } if layout, data or result is NULL.\n
+ *         {@link JSVM_GENERIC_FAILURE } if a string field can not be created.\n
+ * @since 26
+ */
+JSVM_EXTERN JSVM_Status OH_JSVM_StructToObject(JSVM_Env env,
+                                               JSVM_StructLayout layout,
+                                               const void* data,
+                                               JSVM_Value* result);
+
+/**
+ * @brief This API converts the properties of a JavaScript object to a C struct according to a struct layout.
+ * Number conversions follow OH_JSVM_GetCbTypedArgs, strings are copied into char array fields and
+ * truncated if needed. const char* fields are left untouched. On failure, the fields before the
+ * failing one have been written.
+ *
+ * @param env The environment that the API is invoked under.
+ * @param layout The layout of the struct.
+ * @param object The object to be converted.
+ * @param data Pointer to the struct.
+ * @return Returns JSVM funtions result code.
+ *         {@link JSVM_OK } if the function executed successfully.\n
+ *         {@link JSVM_INVALID_ARG } if layout, data or object is NULL.\n
+ *         {@link JSVM_OBJECT_EXPECTED } if object or the property of a JSVM_FIELD_STRUCT field is not an object.\n
+ *         {@link JSVM_NUMBER_EXPECTED } if the property of a number field is not a number.\n
+ *         {@link JSVM_BOOLEAN_EXPECTED } if the property of a JSVM_FIELD_BOOL field is not a boolean.\n
+ *         {@link JSVM_STRING_EXPECTED } if the property of a JSVM_FIELD_UTF8 field is not a string.\n
+ *         {@link JSVM_PENDING_EXCEPTION } if a getter threw.\n
+ * @since 26
+ */
+JSVM_EXTERN JSVM_Status OH_JSVM_ObjectToStruct(JSVM_Env env,
+                                               JSVM_StructLayout layout,
+                                               JSVM_Value object,
+                                               void* data);
+
+/**
+ * @brief This API creates a JavaScript array from the elements of a native buffer in a single call.
+ *
+ * @param env The environment that the API is invoked under.
+ * @param kind The C type of the elements in data.
+ * @param data Pointer to the first element of the buffer.
+ * @param length Number of elements in the buffer.
+ * @param result JSVM_Value representing the created array.
+ * @return Returns JSVM funtions result code.
+ *         {@link JSVM_OK } if the function executed successfully.\n
+ *         {@link JSVM_INVALID_ARG } if result is NULL, data is NULL while length is not zero, kind is invalid,
+ *         an element of a JSVM_ELEMENT_VALUE buffer is NULL, or length exceeds the maximum length of an array
+ *         created from a list of elements (2^27 - 3).\n
+ * @since 26
+ */
+JSVM_EXTERN JSVM_Status OH_JSVM_CreateArrayFromBuffer(JSVM_Env env,
+                                                      JSVM_ElementKind kind,
+                                                      const void* data,
+                                                      size_t length,
+                                                      JSVM_Value* result);
+
+/**
+ * @brief This API copies the elements of a JavaScript array to a native buffer in a single call.
+ * Number conversions follow OH_JSVM_GetCbTypedArgs. At most length elements are copied; the copy
+ * stops at the first element that does not match kind, and the elements before it have been written.
+ *
+ * @param env The environment that the API is invoked under.
+ * @param array The JavaScript array to be copied.
+ * @param kind The C type of the elements in buffer.
+ * @param buffer Pointer to the first element of the buffer.
+ * @param length Capacity of the buffer, in elements.
+ * @param copied Optional, returns the number of elements written to buffer.
+ * @return Returns JSVM funtions result code.
+ *         {@link JSVM_OK } if the function executed successfully.\n
+ *         {@link JSVM_INVALID_ARG } if array is NULL, buffer is NULL while length is not zero or kind is
+ *         invalid.\n
+ *         {@link JSVM_ARRAY_EXPECTED } if array is not an array.\n
+ *         {@link JSVM_NUMBER_EXPECTED } if an element is not a number for a number kind.\n
+ *         {@link JSVM_BOOLEAN_EXPECTED } if an element is not a boolean for JSVM_ELEMENT_BOOL.\n
+ *         {@link JSVM_PENDING_EXCEPTION } if a getter threw for JSVM_ELEMENT_VALUE.\n
+ * @since 26
+ */
+JSVM_EXTERN JSVM_Status OH_JSVM_CopyArrayToBuffer(JSVM_Env env,
+                                                  JSVM_Value array,
+                                                  JSVM_ElementKind kind,
+                                                  void* buffer,
+                                                  size_t length,
+                                                  size_t* copied);
+
+/**
+ * @brief This API exposes the characters of a JavaScript string without copying them. The string is flattened
+ * if needed, and data points to its one-byte or two-byte characters according to encoding. The data stays valid
+ * until the view is released by OH_JSVM_ReleaseStringView, provided that the caller follows this rule while the
+ * view is alive: no JavaScript is executed, and no API that may allocate on the JavaScript heap is called, which
+ * includes creating any JavaScript value. Otherwise the garbage collector may move the string and data points to
+ * freed memory. The rule is not enforced in release builds. Views must be released in the reverse order of their
+ * creation, before the handle scope of value is closed.
+ *
+ * @param env The environment that the API is invoked under.
+ * @param value JSVM_Value representing the JavaScript string.
+ * @param result The created string view.
+ * @param data Returns the pointer to the first character of the string. The string is not null terminated.
+ * @param length Returns the number of characters of the string.
+ * @param encoding Returns the encoding of the characters.
+ * @return Returns JSVM funtions result code.
+ *         {@link JSVM_OK } if the function executed successfully.\n
+ *         {@link JSVM_INVALID_ARG } if value, result, data, length or encoding is NULL.\n
+ *         {@link JSVM_STRING_EXPECTED } if value is not a string.\n
+ * @since 26
+ */
+JSVM_EXTERN JSVM_Status OH_JSVM_GetStringView(JSVM_Env env,
+                                              JSVM_Value value,
+                                              JSVM_StringView* result,
+                                              const void** data,
+                                              size_t* length,
+                                              JSVM_StringEncoding* encoding);
+
+/**
+ * @brief This API releases a string view created by OH_JSVM_GetStringView. The data returned with the view
+ * must not be accessed afterwards.
+ *
+ * @param env The environment that the API is invoked under.
+ * @param view The string view to be released.
+ * @return Returns JSVM funtions result code.
+ *         {@link JSVM_OK } if the function executed successfully.\n
+ *         {@link JSVM_INVALID_ARG } if view is NULL.\n
+ * @since 26
+ */
+JSVM_EXTERN JSVM_Status OH_JSVM_ReleaseStringView(JSVM_Env env, JSVM_StringView view);
+
+/**
+ * @brief This API enables, resizes or disables the string cache of the environment. While enabled,
+ * OH_JSVM_CreateStringUtf8 returns the same internalized string for repeated short strings instead of allocating
+ * a new one per call, and evicts the least recently used string when the cache is full. Strings longer than 64
+ * bytes are not cached. Changing the capacity drops the cached strings and resets the statistics.
+ *
+ * @param env The environment that the API is invoked under.
+ * @param capacity Maximum number of cached strings, 0 disables the cache. The cache is disabled by default.
+ * @return Returns JSVM funtions result code.
+ *         {@link JSVM_OK } if the function executed successfully.\n
+ * @since 26
+ */
+JSVM_EXTERN JSVM_Status OH_JSVM_SetStringCacheCapacity(JSVM_Env env, size_t capacity);
+
+/**
+ * @brief This API returns the hit and miss counts of the string cache of the environment since it was enabled.
+ * Both are 0 if the cache is disabled.
+ *
+ * @param env The environment that the API is invoked under.
+ * @param hits Number of strings returned from the cache.
+ * @param misses Number of cacheable strings that were created and added to the cache.
+ * @return Returns JSVM funtions result code.
+ *         {@link JSVM_OK } if the function executed successfully.\n
+ *         {@link JSVM_INVALID_ARG } if hits or misses is NULL.\n
+ * @since 26
+ */
+JSVM_EXTERN JSVM_Status OH_JSVM_GetStringCacheStats(JSVM_Env env, uint64_t* hits, uint64_t* misses);
+
+/**
+ * @brief This API encodes a JavaScript string as null-terminated UTF-8 into memory obtained from an allocator
+ * in a single call. The string is encoded once into a scratch buffer owned by the environment, which is sized for
+ * the worst case of three bytes per UTF-16 code unit, reused and overwritten by the next such call and freed with
+ * the environment. If allocate is not NULL, the result is then copied into memory from allocate, sized exactly, the
+ * encoded length plus the terminator. If allocate is NULL, the result is the scratch buffer itself.
+ *
+ * @param env The environment that the API is invoked under.
+ * @param value JSVM_Value representing the JavaScript string.
+ * @param allocate Optional allocator for the result, the caller owns the returned memory.
+ * @param data Data passed to allocate.
+ * @param result Returns the encoded string.
+ * @param length Optional, returns the number of bytes of the encoded string, excluding the null terminator.
+ * @return Returns JSVM funtions result code.
+ *         {@link JSVM_OK } if the function executed successfully.\n
+ *         {@link JSVM_INVALID_ARG } if value or result is NULL.\n
+ *         {@link JSVM_STRING_EXPECTED } if value is not a string.\n
+ *         {@link JSVM_GENERIC_FAILURE } if allocate returned NULL.\n
+ * @since 26
+ */
+JSVM_EXTERN JSVM_Status OH_JSVM_GetValueStringUtf8Alloc(JSVM_Env env,
+                                                        JSVM_Value value,
+                                                        JSVM_AllocateCallback allocate,
+                                                        void* data,
+                                                        char** result,
+                                                        size_t* length);
+
+/**
+ * @brief This API encodes all strings of a JavaScript array as UTF-8 into one contiguous buffer, in a single
+ * call. String i occupies the bytes from offsets[i] to offsets[i + 1] of the buffer, without null terminator, and
+ * the buffer is terminated by a null byte after the last string. The buffer is allocated like in
+ * OH_JSVM_GetValueStringUtf8Alloc, sized exactly for the encoded strings and the terminator. The strings are
+ * encoded once into the scratch buffer of the environment and then copied, if allocate is not NULL.
+ *
+ * @param env The environment that the API is invoked under.
+ * @param array The JavaScript array of strings.
+ * @param allocate Optional allocator for the buffer, the caller owns the returned memory. If NULL, the scratch
+ * buffer of the environment is used.
+ * @param data Data passed to allocate.
+ * @param buffer Returns the buffer holding the encoded strings.
+ * @param offsets Array receiving the start offset of each string, followed by the end offset of the last one.
+ * @param offsetsLength Number of entries of offsets, at least the length of array plus one.
+ * @return Returns JSVM funtions result code.
+ *         {@link JSVM_OK } if the function executed successfully.\n
+ *         {@link JSVM_INVALID_ARG } if array, buffer or offsets is NULL, or offsetsLength is too small.\n
+ *         {@link JSVM_ARRAY_EXPECTED } if array is not an array.\n
+ *         {@link JSVM_STRING_EXPECTED } if an element of array is not a string.\n
+ *         {@link JSVM_GENERIC_FAILURE } if allocate returned NULL.\n
+ *         {@link JSVM_PENDING_EXCEPTION } if reading an element threw.\n
+ * @since 26
+ */
+JSVM_EXTERN JSVM_Status OH_JSVM_GetStringArrayUtf8(JSVM_Env env,
+                                                   JSVM_Value array,
+                                                   JSVM_AllocateCallback allocate,
+                                                   void* data,
+                                                   char** buffer,
+                                                   size_t* offsets,
+                                                   size_t offsetsLength);
+
+/**
+ * @brief This API creates an external JavaScript string backed by a read-only memory mapping of a file, such as
+ * a script source, instead of a heap copy. The mapping is released when the string is collected, and is reported
+ * to the garbage collector as external memory. With JSVM_STRING_LATIN1 the file must be ASCII, so that UTF-8
+ * files are not misread; with JSVM_STRING_UTF16 it holds UTF-16 code units in native byte order. The content is
+ * copied when external strings are not supported.
+ *
+ * @param env The environment that the API is invoked under.
+ * @param path Path of the file, encoded as null-terminated UTF8 string.
+ * @param encoding Encoding of the file content.
+ * @param result A JSVM_Value representing the JavaScript string.
+ * @param copied Returns true if the content was copied into a non-external string, false otherwise.
+ * @return Returns JSVM funtions result code.
+ *         {@link JSVM_OK } if the function executed successfully.\n
+ *         {@link JSVM_INVALID_ARG } if path, result or copied is NULL, encoding is invalid, or the file content
+ *         is not valid for encoding or too long for a string.\n
+ *         {@link JSVM_GENERIC_FAILURE } if the file can not be opened or mapped.\n
+ * @since 26
+ */
+JSVM_EXTERN JSVM_Status OH_JSVM_CreateExternalStringFromFile(JSVM_Env env,
+                                                             const char* path,
+                                                             JSVM_StringEncoding encoding,
+                                                             JSVM_Value* result,
+                                                             bool* copied);
+
+/**
+ * @brief This API defines an object shape from an ordered list of property keys. Objects created from the same
+ * shape by OH_JSVM_CreateObjectWithShape share one hidden class, so they are built without a property transition
+ * per key and stay monomorphic for JavaScript code using them.
+ *
+ * @param env The environment that the API is invoked under.
+ * @param count Number of keys.
+ * @param keys Array of distinct property keys, each a string or a symbol.
+ * @param result The created object shape.
+ * @return Returns JSVM funtions result code.
+ *         {@link JSVM_OK } if the function executed successfully.\n
+ *         {@link JSVM_INVALID_ARG } if result is NULL, keys or one of its elements is NULL, or keys contains
+ *         duplicates.\n
+ *         {@link JSVM_NAME_EXPECTED } if a key is neither a string nor a symbol.\n
+ * @since 26
+ */
+JSVM_EXTERN JSVM_Status OH_JSVM_DefineObjectShape(JSVM_Env env,
+                                                  size_t count,
+                                                  const JSVM_Value* keys,
+                                                  JSVM_ObjectShape* result);
+
+/**
+ * @brief This API releases an object shape created by OH_JSVM_DefineObjectShape. Objects created from the shape
+ * are not affected.
+ *
+ * @param env The environment that the API is invoked under.
+ * @param shape The object shape to be released.
+ * @return Returns JSVM funtions result code.
+ *         {@link JSVM_OK } if the function executed successfully.\n
+ *         {@link JSVM_INVALID_ARG } if shape is NULL.\n
+ * @since 26
+ */
+JSVM_EXTERN JSVM_Status OH_JSVM_ReleaseObjectShape(JSVM_Env env, JSVM_ObjectShape shape);
+
+/**
+ * @brief This API creates a JavaScript object with the keys of a shape as writable, enumerable and configurable
+ * data properties, in the order of the shape.
+ *
+ * @param env The environment that the API is invoked under.
+ * @param shape The object shape.
+ * @param values Array of property values, one for each key of the shape.
+ * @param result JSVM_Value representing the created object.
+ * @return Returns JSVM funtions result code.
+ *         {@link JSVM_OK } if the function executed successfully.\n
+ *         {@link JSVM_INVALID_ARG } if shape or result is NULL, or values or one of its elements is NULL.\n
+ * @since 26
+ */
+JSVM_EXTERN JSVM_Status OH_JSVM_CreateObjectWithShape(JSVM_Env env,
+                                                      JSVM_ObjectShape shape,
+                                                      const JSVM_Value* values,
+                                                      JSVM_Value* result);
+
+/**
+ * @brief This API visits the elements of a JavaScript array in index order with a native callback, in a single
+ * call. Holes are visited as undefined. To keep the iteration cheap, the callback must not create JavaScript
+ * values, run JavaScript or modify the array; it may read the elements with APIs such as OH_JSVM_TypeOf,
+ * OH_JSVM_GetValueDouble or OH_JSVM_GetValueBool.
+ *
+ * @param env The environment that the API is invoked under.
+ * @param array The JavaScript array to iterate.
+ * @param callback The callback called for each element, returning false stops the iteration.
+ * @param data Data passed to callback.
+ * @return Returns JSVM funtions result code.
+ *         {@link JSVM_OK } if the function executed successfully.\n
+ *         {@link JSVM_INVALID_ARG } if array or callback is NULL.\n
+ *         {@link JSVM_ARRAY_EXPECTED } if array is not an array.\n
+ *         {@link JSVM_PENDING_EXCEPTION } if reading an element threw.\n
+ * @since 26
+ */
+JSVM_EXTERN JSVM_Status OH_JSVM_ArrayForEach(JSVM_Env env,
+                                             JSVM_Value array,
+                                             JSVM_ArrayElementCallback callback,
+                                             void* data);
+
+/**
+ * @brief This API returns the own enumerable string keys of an object as UTF-8, in the order of Object.keys, in a
+ * single call. It is a batch conversion: the keys are collected as by Object.keys on each call, then all of them
+ * are encoded into one buffer owned by the environment, without creating a JSVM_Value per key.
+ *
+ * @param env The environment that the API is invoked under.
+ * @param object The object whose keys are enumerated.
+ * @param keys Returns the array of key names, valid until the next call of this API on env.
+ * @param count Returns the number of key names.
+ * @return Returns JSVM funtions result code.
+ *         {@link JSVM_OK } if the function executed successfully.\n
+ *         {@link JSVM_INVALID_ARG } if object, keys or count is NULL.\n
+ *         {@link JSVM_OBJECT_EXPECTED } if object can not be converted to an object.\n
+ *         {@link JSVM_PENDING_EXCEPTION } if a proxy trap threw.\n
+ * @since 26
+ */
+JSVM_EXTERN JSVM_Status OH_JSVM_GetOwnKeysUtf8(JSVM_Env env,
+                                               JSVM_Value object,
+                                               const JSVM_KeyName** keys,
+                                               size_t* count);
+
+/**
+ * @brief This API parses JSON text from a native UTF-8 buffer, like OH_JSVM_JsonParse but without creating the
+ * source string through a separate API call. ASCII text is copied without UTF-8 decoding.
+ *
+ * @param env The environment that the API is invoked under.
+ * @param data The UTF-8 encoded JSON text.
+ * @param length The length of data in bytes, or JSVM_AUTO_LENGTH if it is null-terminated.
+ * @param result The parsed value.
+ * @return Returns JSVM funtions result code.
+ *         {@link JSVM_OK } if the function executed successfully.\n
+ *         {@link JSVM_INVALID_ARG } if result is NULL, data is NULL while length is not zero, or length is larger
+ *         than INT_MAX.\n
+ *         {@link JSVM_PENDING_EXCEPTION } if the text is not valid JSON.\n
+ * @since 26
+ */
+JSVM_EXTERN JSVM_Status OH_JSVM_JsonParseUtf8(JSVM_Env env, const char* data, size_t length, JSVM_Value* result);
+
+/**
+ * @brief This API parses Latin-1 JSON text from a native buffer without copying it into the JavaScript heap. The
+ * text is wrapped in an external string as in OH_JSVM_CreateExternalStringLatin1, so the buffer must stay valid
+ * until finalizeCallback is called, which may be after the parse returns, since parsed strings can refer to it.
+ *
+ * @param env The environment that the API is invoked under.
+ * @param data The Latin-1 encoded JSON text.
+ * @param length The length of data in bytes, or JSVM_AUTO_LENGTH if it is null-terminated.
+ * @param finalizeCallback Optional callback to call when the text is no longer referenced.
+ * @param finalizeHint Optional hint to pass to the finalize callback.
+ * @param result The parsed value.
+ * @param copied Returns true if the text was copied because external strings are not supported, in which case
+ * finalizeCallback has already been called.
+ * @return Returns JSVM funtions result code.
+ *         {@link JSVM_OK } if the function executed successfully.\n
+ *         {@link JSVM_INVALID_ARG } if result or copied is NULL, or data is NULL while length is not zero.\n
+ *         {@link JSVM_PENDING_EXCEPTION } if the text is not valid JSON.\n
+ * @since 26
+ */
+JSVM_EXTERN JSVM_Status OH_JSVM_JsonParseExternalLatin1(JSVM_Env env,
+                                                        char* data,
+                                                        size_t length,
+                                                        JSVM_Finalize finalizeCallback,
+                                                        void* finalizeHint,
+                                                        JSVM_Value* result,
+                                                        bool* copied);
+
+/**
+ * @brief This API stringifies a value like OH_JSVM_JsonStringify, and writes the result to a native stream as
+ * UTF-8 text. The text is encoded in chunks of bounded size, so no UTF-8 copy of the whole result is made. The
+ * stream is called with data set to NULL and size set to 0 after the last chunk, unless it aborted the write by
+ * returning false. The stream must not call JSVM APIs.
+ *
+ * @param env The environment that the API is invoked under.
+ * @param jsonObject The value to stringify.
+ * @param stream The output stream callback that receives the chunks.
+ * @param streamData The data passed to the stream callback.
+ * @return Returns JSVM funtions result code.
+ *         {@link JSVM_OK } if the function executed successfully.\n
+ *         {@link JSVM_INVALID_ARG } if jsonObject or stream is NULL.\n
+ *         {@link JSVM_CANCELLED } if the stream returned false.\n
+ *         {@link JSVM_PENDING_EXCEPTION } if the value can not be stringified, e.g. it is cyclic or toJSON threw.\n
+ * @since 26
+ */
+JSVM_EXTERN JSVM_Status OH_JSVM_JsonStringifyToStream(JSVM_Env env,
+                                                      JSVM_Value jsonObject,
+                                                      JSVM_OutputStream stream,
+                                                      void* streamData);
+
 #endif // JSVM_EXPERIMENTAL
 
 // clang-format on
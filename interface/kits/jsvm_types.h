@@ -220,6 +220,21 @@ typedef enum {
     JSVM_NO_RECEIVER_CHECK = 1 << 3,
     /** Used with OH_JSVM_DefineClass to distinguish static properties from instance properties. */
     JSVM_STATIC = 1 << 10,
+#ifdef JSVM_EXPERIMENTAL
+    /** Used with method descriptors to mark that the method points to the callback member of a
+     *  JSVM_FastCallbackStruct, so the function can also be invoked through the fast call path.
+     *  Supported by OH_JSVM_DefineProperties and the class definition APIs, whose method type information
+     *  is kept by the VM, once per fast function and signature. Other APIs treat the method as a regular
+     *  JSVM_Callback.
+     */
+    JSVM_FAST_CALL = 1 << 4,
+    /** Used with getter descriptors to define a lazy data property. The getter is called once, on first
+     *  access, and the property is then replaced by a data property holding the returned value.
+     *  JSVM_WRITABLE applies to that data property, and the setter must be NULL.
+     *  With OH_JSVM_DefineClass, non-static lazy data properties are defined on each instance.
+     */
+    JSVM_LAZY_DATA = 1 << 5,
+#endif // JSVM_EXPERIMENTAL
     /** Default for class methods. */
     JSVM_DEFAULT_METHOD = JSVM_WRITABLE | JSVM_CONFIGURABLE,
     /** Class method with no receiver check*/
@@ -988,6 +1003,27 @@ typedef enum {
     JSVM_DEFINE_CLASS_WITH_COUNT,
     /** Defining a class with property handler. */
     JSVM_DEFINE_CLASS_WITH_PROPERTY_HANDLER,
+#ifdef JSVM_EXPERIMENTAL
+    /** Defining a class whose instances keep the native object of OH_JSVM_Wrap in internal fields,
+     *  so that OH_JSVM_Unwrap is a field load. Native objects wrapped in such instances must not be NULL
+     *  and must be at least 2-byte aligned. The type tag of OH_JSVM_TypeTagObject is kept in a field as
+     *  well, so OH_JSVM_CheckObjectTypeTag compares it in place. The field points to a copy of the tag that
+     *  the VM keeps until it is destroyed, so the number of distinct tags used with such instances must be
+     *  bounded, e.g. one constant tag per native type. The option content is unused.
+     */
+    JSVM_DEFINE_CLASS_WITH_WRAPPER_FIELD,
+    /** Defining a class whose template is shared by all envs of the VM, with the class id in content.num.
+     *  The first definition of an id builds the template, later ones in any env of the VM only instantiate
+     *  it, and ignore their constructor, properties other than static ones, and options. The callbacks
+     *  must therefore stay valid as long as the VM. Classes with a parent class or a property handler are
+     *  not shared.
+     */
+    JSVM_DEFINE_CLASS_WITH_ID,
+    /** Defining a class whose indexed properties are the elements of a native array, with a pointer to a
+     *  JSVM_NativeElements in content.ptr. It replaces the indexed callbacks of a property handler.
+     */
+    JSVM_DEFINE_CLASS_WITH_NATIVE_ELEMENTS,
+#endif // JSVM_EXPERIMENTAL
 } JSVM_DefineClassOptionsId;
 
 /**
@@ -1059,4 +1095,291 @@ typedef struct JSVM_DeserializeResult__* JSVM_DeserializeResult;
  */
 typedef void(JSVM_CDECL* JSVM_HandlerForHeapThreshold)(JSVM_VM vm, uint64_t threshold, void* data);
 
+#ifdef JSVM_EXPERIMENTAL
+/**
+ * @brief C types usable in the signature of a fast call function.
+ *
+ * @since 26
+ */
+typedef enum {
+    /** void, only valid as return type. */
+    JSVM_FAST_VOID,
+    /** bool. */
+    JSVM_FAST_BOOL,
+    /** int32_t. */
+    JSVM_FAST_INT32,
+    /** uint32_t. */
+    JSVM_FAST_UINT32,
+    /** int64_t. */
+    JSVM_FAST_INT64,
+    /** uint64_t. */
+    JSVM_FAST_UINT64,
+    /** float. */
+    JSVM_FAST_FLOAT32,
+    /** double. */
+    JSVM_FAST_FLOAT64,
+} JSVM_FastCallType;
+
+/**
+ * @brief Native function with a declared C signature which can be called by optimized js code
+ * without going through the regular JSVM_Callback.
+ *
+ * fastCallback is a C function whose first parameter is the receiver (JSVM_Value), followed by
+ * argc parameters of the types listed in argTypes, and returns returnType. It must not call any
+ * JSVM-API, allocate js objects, or throw. Whenever the fast path cannot be taken, the regular
+ * callback is invoked instead, so both must behave the same.
+ *
+ * @since 26
+ */
+typedef struct {
+    /** The regular callback, must be the first member. */
+    JSVM_CallbackStruct callback;
+    /** Address of the C function. */
+    const void* fastCallback;
+    /** Return type of the C function. */
+    JSVM_FastCallType returnType;
+    /** Number of arguments, not including the receiver. */
+    size_t argc;
+    /** Types of the arguments, not including the receiver. */
+    const JSVM_FastCallType* argTypes;
+} JSVM_FastCallbackStruct;
+
+/**
+ * @brief Pointer type for native function with fast call signature.
+ *
+ * @since 26
+ */
+typedef JSVM_FastCallbackStruct* JSVM_FastCallback;
+
+/**
+ * @brief Expected type of an argument decoded by OH_JSVM_GetCbTypedArgs.
+ *
+ * @since 26
+ */
+typedef enum {
+    /** number decoded into int32_t. */
+    JSVM_ARG_INT32,
+    /** number decoded into uint32_t. */
+    JSVM_ARG_UINT32,
+    /** number decoded into int64_t. */
+    JSVM_ARG_INT64,
+    /** number decoded into double. */
+    JSVM_ARG_DOUBLE,
+    /** boolean decoded into bool. */
+    JSVM_ARG_BOOL,
+    /** string copied as UTF8 into a caller provided buffer. */
+    JSVM_ARG_STRING_UTF8,
+    /** external decoded into its native pointer. */
+    JSVM_ARG_EXTERNAL,
+    /** TypedArray decoded into its data pointer and element count. */
+    JSVM_ARG_TYPEDARRAY,
+} JSVM_ArgType;
+
+/**
+ * @brief Describes how one argument is decoded by OH_JSVM_GetCbTypedArgs.
+ *
+ * @since 26
+ */
+typedef struct {
+    /** Expected type of the argument. */
+    JSVM_ArgType type;
+    /** Where the decoded value is stored: int32_t*, uint32_t*, int64_t*, double*, bool*, char* buffer
+     *  for JSVM_ARG_STRING_UTF8, void** for JSVM_ARG_EXTERNAL and JSVM_ARG_TYPEDARRAY. */
+    void* value;
+    /** Size of the char buffer, only used by JSVM_ARG_STRING_UTF8. */
+    size_t bufsize;
+    /** Optional. Receives the number of bytes copied for JSVM_ARG_STRING_UTF8, or the element count
+     *  for JSVM_ARG_TYPEDARRAY. */
+    size_t* length;
+} JSVM_ArgSpec;
+
+/**
+ * @brief To represent a JavaScript function call prepared by OH_JSVM_PrepareCall.
+ *
+ * @since 26
+ */
+typedef struct JSVM_PreparedCall__* JSVM_PreparedCall;
+
+/**
+ * @brief To represent a property name created once by OH_JSVM_CreatePropertyKey and reused for named
+ * property access.
+ *
+ * @since 26
+ */
+typedef struct JSVM_PropertyKey__* JSVM_PropertyKey;
+
+/**
+ * @brief To represent the layout of a C struct, created by OH_JSVM_CreateStructLayout.
+ *
+ * @since 26
+ */
+typedef struct JSVM_StructLayout__* JSVM_StructLayout;
+
+/**
+ * @brief C type of a struct field described by JSVM_StructField.
+ *
+ * @since 26
+ */
+typedef enum {
+    /** int32_t, converted to number. */
+    JSVM_FIELD_INT32,
+    /** uint32_t, converted to number. */
+    JSVM_FIELD_UINT32,
+    /** int64_t, converted to number. */
+    JSVM_FIELD_INT64,
+    /** double, converted to number. */
+    JSVM_FIELD_DOUBLE,
+    /** bool, converted to boolean. */
+    JSVM_FIELD_BOOL,
+    /** UTF8 string, converted to string. With size 0 the field is a const char* (NULL becomes null), which is
+     *  only converted from C to JavaScript. Otherwise the field is a char array of the given size. */
+    JSVM_FIELD_UTF8,
+    /** Embedded struct described by a nested layout, converted to object. */
+    JSVM_FIELD_STRUCT,
+} JSVM_StructFieldType;
+
+/**
+ * @brief Describes one field of a C struct.
+ *
+ * @since 26
+ */
+typedef struct {
+    /** Property name of the field, encoded as null-terminated UTF8 string. */
+    const char* name;
+    /** Offset of the field in the struct, in bytes. */
+    size_t offset;
+    /** C type of the field. */
+    JSVM_StructFieldType type;
+    /** Size of the char array for JSVM_FIELD_UTF8, 0 for a const char* field. Ignored by other types. */
+    size_t size;
+    /** Layout of the embedded struct for JSVM_FIELD_STRUCT. Ignored by other types. */
+    JSVM_StructLayout nested;
+} JSVM_StructField;
+
+/**
+ * @brief C type of the elements of a native buffer copied to or from a JavaScript array.
+ *
+ * @since 26
+ */
+typedef enum {
+    /** int32_t, converted to number. */
+    JSVM_ELEMENT_INT32,
+    /** uint32_t, converted to number. */
+    JSVM_ELEMENT_UINT32,
+    /** double, converted to number. */
+    JSVM_ELEMENT_DOUBLE,
+    /** bool, converted to boolean. */
+    JSVM_ELEMENT_BOOL,
+    /** JSVM_Value, stored as is. */
+    JSVM_ELEMENT_VALUE,
+} JSVM_ElementKind;
+
+/**
+ * @brief To represent a read-only view of the characters of a JavaScript string, created by
+ * OH_JSVM_GetStringView.
+ *
+ * @since 26
+ */
+typedef struct JSVM_StringView__* JSVM_StringView;
+
+/**
+ * @brief Encoding of the characters exposed by a JSVM_StringView.
+ *
+ * @since 26
+ */
+typedef enum {
+    /** One byte per character, each byte is a Latin-1 code point. */
+    JSVM_STRING_LATIN1,
+    /** Two bytes per character, each char16_t is a UTF-16 code unit. */
+    JSVM_STRING_UTF16,
+} JSVM_StringEncoding;
+
+/**
+ * @brief Native memory allocator used by OH_JSVM_GetValueStringUtf8Alloc.
+ *
+ * @param size Number of bytes to allocate.
+ * @param data The data passed to OH_JSVM_GetValueStringUtf8Alloc.
+ * @return Pointer to the allocated memory, or NULL if it can not be allocated.
+ * @since 26
+ */
+typedef void* (*JSVM_AllocateCallback)(size_t size, void* data);
+
+/**
+ * @brief To represent an ordered list of property keys, created by OH_JSVM_DefineObjectShape and shared by the
+ * objects created with OH_JSVM_CreateObjectWithShape.
+ *
+ * @since 26
+ */
+typedef struct JSVM_ObjectShape__* JSVM_ObjectShape;
+
+/**
+ * @brief Native callback visiting the elements of an array, used by OH_JSVM_ArrayForEach.
+ *
+ * @param env The environment that the API is invoked under.
+ * @param index Index of the element.
+ * @param element The element, only valid during the callback.
+ * @param data The data passed to OH_JSVM_ArrayForEach.
+ * @return true to visit the next element, false to stop the iteration.
+ * @since 26
+ */
+typedef bool (*JSVM_ArrayElementCallback)(JSVM_Env env, uint32_t index, JSVM_Value element, void* data);
+
+/**
+ * @brief UTF-8 name of a property key, returned by OH_JSVM_GetOwnKeysUtf8.
+ *
+ * @since 26
+ */
+typedef struct {
+    /** The UTF-8 characters, followed by a null terminator. */
+    const char* data;
+    /** Number of bytes, excluding the null terminator. */
+    size_t length;
+} JSVM_KeyName;
+
+/**
+ * @brief Element type of the native array behind the indexed properties of a class.
+ *
+ * @since 26
+ */
+typedef enum {
+    /** Elements are int32_t, stored like an Int32Array. */
+    JSVM_NATIVE_ELEMENT_INT32,
+    /** Elements are double, stored like a Float64Array. */
+    JSVM_NATIVE_ELEMENT_DOUBLE,
+    /** Elements are uint8_t, stored like a Uint8Array. */
+    JSVM_NATIVE_ELEMENT_UINT8,
+} JSVM_NativeElementType;
+
+/**
+ * @brief Locates the native array of an instance. Called on every indexed access, so it must be cheap and must
+ * not call JSVM APIs.
+ *
+ * @param nativeObject The native object wrapped in the instance by OH_JSVM_Wrap.
+ * @param elements The start of the array, aligned for the element type.
+ * @param length The number of elements.
+ * @return false if the instance has no elements.
+ * @since 26
+ */
+typedef bool (*JSVM_NativeElementsAccessor)(void* nativeObject, void** elements, size_t* length);
+
+/**
+ * @brief Native array behind the indexed properties of a class, see JSVM_DEFINE_CLASS_WITH_NATIVE_ELEMENTS.
+ * Indices within the array are read without calling back into JavaScript or the module, and so are writes of
+ * numbers. Writes of other values convert them like stores to typed arrays, which may call JavaScript such as
+ * valueOf. The array is located again after the conversion, and the write is dropped if the index is no longer
+ * within it. Other indices, and instances without a wrapped native object, behave as ordinary objects. Only the
+ * first 2^27 - 3 indices are enumerated.
+ *
+ * @since 26
+ */
+typedef struct {
+    /** The element type. */
+    JSVM_NativeElementType type;
+    /** Returns the array of an instance. */
+    JSVM_NativeElementsAccessor accessor;
+    /** Whether writes to elements are ignored. */
+    bool readOnly;
+} JSVM_NativeElements;
+#endif // JSVM_EXPERIMENTAL
+
 #endif /* ARK_RUNTIME_JSVM_JSVM_TYPE_H */
@@ -17,12 +17,20 @@
 #include <atomic>
 #include <climits> // INT_MAX
 #include <cmath>
+#include <cstddef>
 #include <cstring>
 #include <list>
+#include <map>
+#include <set>
 #include <sstream>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 #include "v8-debug.h"
+#include "v8-fast-api-calls.h"
 #include "v8-internal.h"
 #include "v8-local-handle.h"
 #include "v8-primitive.h"
@@ -155,17 +163,27 @@ static JSVM_Env GetEnvByContext(v8::Local<v8::Context> context)
     return reinterpret_cast<JSVM_Env>(env);
 }
 
+class FastCallInfo;
+
 struct IsolateData {
     explicit IsolateData(v8::StartupData* blob) : blob(blob) {}
 
-    ~IsolateData()
-    {
-        delete blob;
-    }
+    ~IsolateData();
 
     v8::StartupData* blob;
     v8::Eternal<v8::Private> typeTagKey;
     v8::Eternal<v8::Private> wrapperKey;
+    // Type tags of objects with wrapper fields, which point to them from a field. Set nodes do not move.
+    // Tags are never removed, as no object tracks its tag, which is why their number must be bounded.
+    std::set<std::pair<uint64_t, uint64_t>> typeTags;
+    // Class templates shared by all envs of the VM, keyed by the id of JSVM_DEFINE_CLASS_WITH_ID.
+    std::unordered_map<int, v8::Eternal<v8::FunctionTemplate>> classTemplates;
+    // Type information of fast call class methods. Methods can outlive their class, and V8 keeps
+    // raw pointers to it in their templates, so it lives as long as the isolate. Keyed by the fast
+    // function and its signature, so defining a class again reuses it.
+    std::map<std::vector<uintptr_t>, std::unique_ptr<FastCallInfo>> fastCalls;
+    // Callback bundles of functions whose env is destroyed, see CallbackBundle.
+    RefList callbackBundles;
     IsolateOwner isolateOwner;
 };
 
@@ -306,6 +324,184 @@ JSVM_Status NewString(JSVM_Env env, const CCharType* str, size_t length, JSVM_Va
     return ClearLastError(env);
 }
 
+// Copies the first bufsize characters of str to buf if they are ASCII, which then need no UTF-8 encoding.
+// With a null buf, only checks whether the whole string is ASCII. Returns false if str is two-byte or the
+// checked characters are not ASCII.
+bool CopyAsciiString(v8::Isolate* isolate, v8::Local<v8::String> str, char* buf, size_t bufsize, size_t* copied)
+{
+    if (!str->IsOneByte()) {
+        return false;
+    }
+    v8::String::ValueView view(isolate, str);
+    if (!view.is_one_byte()) {
+        return false;
+    }
+    size_t length = static_cast<size_t>(view.length());
+    if (buf != nullptr) {
+        length = std::min(length, bufsize);
+    }
+    if (!jsvm::IsAscii(view.data8(), length)) {
+        return false;
+    }
+    if (buf != nullptr) {
+        std::copy_n(view.data8(), length, reinterpret_cast<uint8_t*>(buf));
+    }
+    *copied = length;
+    return true;
+}
+
+// Exact number of bytes WriteUtf8 writes for str, unpaired surrogates count as replacement characters.
+size_t Utf8Length(v8::Isolate* isolate, v8::Local<v8::String> str)
+{
+    size_t length = 0;
+    if (CopyAsciiString(isolate, str, nullptr, 0, &length)) {
+        return length;
+    }
+#if JSVM_V8_NEW_VERSION
+    return str->Utf8LengthV2(isolate);
+#else
+    return static_cast<size_t>(str->Utf8Length(isolate));
+#endif
+}
+
+// Writes str as UTF-8 to buf without null terminator. Returns the number of bytes written.
+size_t WriteUtf8(v8::Isolate* isolate, v8::Local<v8::String> str, char* buf, size_t bufsize)
+{
+    size_t copied = 0;
+    if (CopyAsciiString(isolate, str, buf, bufsize, &copied)) {
+        return copied;
+    }
+#if JSVM_V8_NEW_VERSION
+    return str->WriteUtf8V2(isolate, buf, bufsize, v8::String::WriteFlags::kReplaceInvalidUtf8);
+#else
+    return static_cast<size_t>(str->WriteUtf8(isolate, buf, static_cast<int>(bufsize), nullptr,
+                                              v8::String::REPLACE_INVALID_UTF8 | v8::String::NO_NULL_TERMINATION));
+#endif
+}
+
+// Allocates the destination of a UTF-8 extraction with the caller allocator, or reuses the scratch
+// buffer of env if there is none. Returns nullptr if the allocator failed.
+// Grows the scratch buffer of env to at least size bytes, keeping its first used bytes.
+char* ReserveScratchBuffer(JSVM_Env env, size_t used, size_t size)
+{
+    if (env->scratchBufferSize < size) {
+        size = std::max(size, env->scratchBufferSize * 2);
+        std::unique_ptr<char[]> grown(new char[size]);
+        std::copy_n(env->scratchBuffer.get(), used, grown.get());
+        env->scratchBuffer = std::move(grown);
+        env->scratchBufferSize = size;
+    }
+    return env->scratchBuffer.get();
+}
+
+// Writes str as UTF-8 to the scratch buffer of env at offset, leaving room for a terminator. Returns the number
+// of bytes written.
+size_t WriteUtf8ToScratch(JSVM_Env env, v8::Local<v8::String> str, size_t offset)
+{
+    // A UTF-16 code unit takes at most three bytes, a surrogate pair takes four.
+    constexpr size_t maxBytesPerUnit = 3;
+    size_t capacity = static_cast<size_t>(str->Length()) * maxBytesPerUnit;
+    char* buf = ReserveScratchBuffer(env, offset, offset + capacity + 1);
+    return WriteUtf8(env->isolate, str, buf + offset, capacity);
+}
+
+// Returns the first size bytes of the scratch buffer of env, copied to memory from allocate if it is given.
+char* TakeScratchBuffer(JSVM_Env env, JSVM_AllocateCallback allocate, void* data, size_t size)
+{
+    if (allocate == nullptr) {
+        return env->scratchBuffer.get();
+    }
+    char* buf = static_cast<char*>(allocate(size, data));
+    if (buf != nullptr) {
+        std::copy_n(env->scratchBuffer.get(), size, buf);
+    }
+    return buf;
+}
+
+// Encodes a code point to out, which must have room for four bytes. Returns the number of bytes written.
+size_t EncodeUtf8(uint32_t codePoint, char* out)
+{
+    auto bytes = reinterpret_cast<uint8_t*>(out);
+    if (codePoint < 0x80) {
+        bytes[0] = static_cast<uint8_t>(codePoint);
+        return 1;
+    }
+    if (codePoint < 0x800) {
+        bytes[0] = static_cast<uint8_t>(0xC0 | (codePoint >> 6));
+        bytes[1] = static_cast<uint8_t>(0x80 | (codePoint & 0x3F));
+        return 2;
+    }
+    if (codePoint < 0x10000) {
+        bytes[0] = static_cast<uint8_t>(0xE0 | (codePoint >> 12));
+        bytes[1] = static_cast<uint8_t>(0x80 | ((codePoint >> 6) & 0x3F));
+        bytes[2] = static_cast<uint8_t>(0x80 | (codePoint & 0x3F));
+        return 3;
+    }
+    bytes[0] = static_cast<uint8_t>(0xF0 | (codePoint >> 18));
+    bytes[1] = static_cast<uint8_t>(0x80 | ((codePoint >> 12) & 0x3F));
+    bytes[2] = static_cast<uint8_t>(0x80 | ((codePoint >> 6) & 0x3F));
+    bytes[3] = static_cast<uint8_t>(0x80 | (codePoint & 0x3F));
+    return 4;
+}
+
+// Writes str as UTF-8 to stream in chunks of the stream chunk size, so that no UTF-8 copy of the whole
+// string is made. Unpaired surrogates are replaced by U+FFFD. Returns false if the stream aborted.
+// As the characters are read in place, the stream must not call into the VM.
+bool WriteUtf8ToStream(v8::Isolate* isolate, v8::Local<v8::String> str, v8::OutputStream* stream)
+{
+    constexpr size_t maxUtf8CharSize = 4;
+    constexpr uint32_t replacementChar = 0xFFFD;
+    size_t chunkSize = std::max(static_cast<size_t>(stream->GetChunkSize()), maxUtf8CharSize);
+    std::unique_ptr<char[]> chunk(new char[chunkSize]);
+    size_t used = 0;
+    auto flush = [&]() {
+        if (used == 0) {
+            return true;
+        }
+        auto writeResult = stream->WriteAsciiChunk(chunk.get(), static_cast<int>(used));
+        used = 0;
+        return writeResult == v8::OutputStream::kContinue;
+    };
+
+    v8::String::ValueView view(isolate, str);
+    size_t length = static_cast<size_t>(view.length());
+    size_t i = 0;
+    if (view.is_one_byte()) {
+        const uint8_t* chars = view.data8();
+        while (i < length) {
+            if (chunkSize - used < maxUtf8CharSize && !flush()) {
+                return false;
+            }
+            size_t count = std::min(length - i, chunkSize - used);
+            if (jsvm::IsAscii(chars + i, count)) {
+                std::copy_n(chars + i, count, reinterpret_cast<uint8_t*>(chunk.get() + used));
+                used += count;
+                i += count;
+                continue;
+            }
+            // Encode the window one by one, then retry the ASCII copy for the rest.
+            for (size_t end = i + count; i < end && chunkSize - used >= maxUtf8CharSize; ++i) {
+                used += EncodeUtf8(chars[i], chunk.get() + used);
+            }
+        }
+    } else {
+        const uint16_t* chars = view.data16();
+        while (i < length) {
+            if (chunkSize - used < maxUtf8CharSize && !flush()) {
+                return false;
+            }
+            uint32_t codePoint = chars[i++];
+            if ((codePoint & 0xFC00) == 0xD800 && i < length && (chars[i] & 0xFC00) == 0xDC00) {
+                codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (chars[i++] - 0xDC00);
+            } else if ((codePoint & 0xF800) == 0xD800) {
+                codePoint = replacementChar;
+            }
+            used += EncodeUtf8(codePoint, chunk.get() + used);
+        }
+    }
+    return flush();
+}
+
 template<typename CharType, typename CreateAPI, typename StringMaker>
 JSVM_Status NewExternalString(JSVM_Env env,
                               CharType* str,
@@ -362,8 +558,10 @@ v8::PropertyAttribute V8PropertyAttributesFromDescriptor(const JSVM_PropertyDesc
 
     // The JSVM_WRITABLE attribute is ignored for accessor descriptors, but
     // V8 would throw `TypeError`s on assignment with nonexistence of a setter.
-    if ((descriptor->getter == nullptr && descriptor->setter == nullptr) &&
-        (descriptor->attributes & JSVM_WRITABLE) == 0) {
+    // Lazy data properties become data properties, so it applies to them.
+    bool isAccessor = (descriptor->getter != nullptr || descriptor->setter != nullptr) &&
+                      (descriptor->attributes & JSVM_LAZY_DATA) == 0;
+    if (!isAccessor && (descriptor->attributes & JSVM_WRITABLE) == 0) {
         attributeFlags |= v8::PropertyAttribute::ReadOnly;
     }
 
@@ -444,6 +642,72 @@ private:
     std::optional<RuntimeReference *> m_wrapper;
 };
 
+// Largest length of the FixedArray backing an array built from a list of elements. V8 aborts the
+// process when asked for a longer one, instead of throwing.
+constexpr size_t K_MAX_ARRAY_ELEMENTS_LENGTH = 128 * 1024 * 1024 - 3;
+
+// Instances of classes defined with JSVM_DEFINE_CLASS_WITH_WRAPPER_FIELD keep the wrapped native object in
+// internal fields instead of a private property. The tag field tells them apart from other objects with
+// internal fields, the reference field holds the finalizer reference, if there is one. The type tag field
+// takes the place of the typeTag private property.
+enum WrapperFieldIndex {
+    K_WRAPPER_TAG_FIELD = 0,
+    K_WRAPPER_DATA_FIELD = 1,
+    K_WRAPPER_REFERENCE_FIELD = 2,
+    K_WRAPPER_TYPE_TAG_FIELD = 3,
+    K_WRAPPER_FIELD_COUNT = 4,
+};
+
+// An arbitrary Smi, internal fields of other objects are undefined or zero.
+constexpr int32_t K_WRAPPER_FIELD_TAG = 0x2A5E4D31;
+
+void InitWrapperFields(v8::Isolate* isolate, v8::Local<v8::Object> obj)
+{
+    if (obj->InternalFieldCount() < K_WRAPPER_FIELD_COUNT) {
+        return;
+    }
+    obj->SetInternalField(K_WRAPPER_TAG_FIELD, v8::Integer::New(isolate, K_WRAPPER_FIELD_TAG));
+    obj->SetAlignedPointerInInternalField(K_WRAPPER_DATA_FIELD, nullptr);
+    obj->SetAlignedPointerInInternalField(K_WRAPPER_REFERENCE_FIELD, nullptr);
+    obj->SetAlignedPointerInInternalField(K_WRAPPER_TYPE_TAG_FIELD, nullptr);
+}
+
+bool HasWrapperFields(v8::Local<v8::Object> obj)
+{
+    if (obj->InternalFieldCount() < K_WRAPPER_FIELD_COUNT) {
+        return false;
+    }
+    v8::Local<v8::Value> tag = obj->GetInternalField(K_WRAPPER_TAG_FIELD).As<v8::Value>();
+    return tag->IsInt32() && tag.As<v8::Int32>()->Value() == K_WRAPPER_FIELD_TAG;
+}
+
+const std::pair<uint64_t, uint64_t>* GetWrapperTypeTag(v8::Local<v8::Object> obj)
+{
+    return static_cast<const std::pair<uint64_t, uint64_t>*>(
+        obj->GetAlignedPointerFromInternalField(K_WRAPPER_TYPE_TAG_FIELD));
+}
+
+void SetWrapperTypeTag(v8::Isolate* isolate, v8::Local<v8::Object> obj, const JSVM_TypeTag* typeTag)
+{
+    auto& typeTags = GetIsolateData(isolate)->typeTags;
+    auto* tag = &*typeTags.emplace(typeTag->lower, typeTag->upper).first;
+    obj->SetAlignedPointerInInternalField(K_WRAPPER_TYPE_TAG_FIELD, const_cast<std::pair<uint64_t, uint64_t>*>(tag));
+}
+
+// Returns the native object wrapped in obj by OH_JSVM_Wrap, or nullptr if there is none.
+void* GetWrappedNative(v8::Isolate* isolate, v8::Local<v8::Object> obj)
+{
+    if (HasWrapperFields(obj)) {
+        return obj->GetAlignedPointerFromInternalField(K_WRAPPER_DATA_FIELD);
+    }
+    v8::Local<v8::Value> val;
+    if (!obj->GetPrivate(isolate->GetCurrentContext(), JSVM_PRIVATE_KEY(isolate, wrapper)).ToLocal(&val) ||
+        !val->IsExternal()) {
+        return nullptr;
+    }
+    return static_cast<RuntimeReference*>(val.As<v8::External>()->Value())->GetData();
+}
+
 enum UnwrapAction { KEEP_WRAP, REMOVE_WRAP };
 
 JSVM_Status Unwrap(JSVM_Env env, JSVM_Value jsObject, void** result, UnwrapAction action)
@@ -461,6 +725,23 @@ JSVM_Status Unwrap(JSVM_Env env, JSVM_Value jsObject, void** result, UnwrapActio
     RuntimeReference* reference = nullptr;
     if (value->IsExternal()) {
         reference = v8impl::ExternalWrapper::From(value.As<v8::External>())->GetWrapper();
+    } else if (HasWrapperFields(value.As<v8::Object>())) {
+        v8::Local<v8::Object> obj = value.As<v8::Object>();
+        void* data = obj->GetAlignedPointerFromInternalField(K_WRAPPER_DATA_FIELD);
+        RETURN_STATUS_IF_FALSE(env, data != nullptr, JSVM_INVALID_ARG);
+        if (result) {
+            *result = data;
+        }
+        if (action == REMOVE_WRAP) {
+            void* field = obj->GetAlignedPointerFromInternalField(K_WRAPPER_REFERENCE_FIELD);
+            reference = static_cast<RuntimeReference*>(field);
+            obj->SetAlignedPointerInInternalField(K_WRAPPER_DATA_FIELD, nullptr);
+            obj->SetAlignedPointerInInternalField(K_WRAPPER_REFERENCE_FIELD, nullptr);
+            if (reference != nullptr) {
+                v8impl::RuntimeReference::DeleteReference(reference);
+            }
+        }
+        return JSVM_OK;
     } else {
         v8::Local<v8::Object> obj = value.As<v8::Object>();
 
@@ -494,19 +775,90 @@ JSVM_Status Unwrap(JSVM_Env env, JSVM_Value jsObject, void** result, UnwrapActio
 // calling through N-API.
 // Ref: benchmark/misc/function_call
 // Discussion (incl. perf. data): https://github.com/nodejs/node/pull/21072
-class CallbackBundle {
+// The bundle lives as long as its v8::External, not as long as its env: functions
+// can be reached from other envs of the VM after the creating env is destroyed.
+class CallbackBundle final : public RefTracker {
 public:
     // Creates an object to be made available to the static function callback
-    // wrapper, used to retrieve the native callback function and data pointer.
-    static inline v8::Local<v8::Value> New(JSVM_Env env, JSVM_Callback cb)
+    // wrapper, used to retrieve the env, native callback function and data pointer.
+    // Functions created while a snapshot may be taken keep the bare callback in
+    // the v8::External, since only registered external references can be
+    // serialized. Check IsBundled to pick the matching static wrapper.
+    // Shared functions are not bound to env either, as their templates are used by all envs of the VM.
+    static inline v8::Local<v8::Value> New(JSVM_Env env, JSVM_Callback cb, bool shared = false)
     {
-        return v8::External::New(env->isolate, cb);
+        if (shared || !IsBundled(env)) {
+            return v8::External::New(env->isolate, cb);
+        }
+        CallbackBundle* bundle = new CallbackBundle(env, cb);
+        v8::Local<v8::External> cbdata = v8::External::New(env->isolate, bundle);
+        bundle->persistent.Reset(env->isolate, cbdata);
+        bundle->persistent.SetWeak(bundle, WeakCallback, v8::WeakCallbackType::kParameter);
+        return cbdata;
     }
 
     static inline v8::Local<v8::Value> New(JSVM_Env env, v8impl::JSVM_PropertyHandlerCfgStruct* cb)
     {
         return v8::External::New(env->isolate, cb);
     }
+
+    static inline bool IsBundled(JSVM_Env env)
+    {
+        return GetIsolateSnapshotCreator(env->isolate) == nullptr;
+    }
+
+    static inline CallbackBundle* From(v8::Local<v8::Value> cbdata)
+    {
+        return static_cast<CallbackBundle*>(cbdata.As<v8::External>()->Value());
+    }
+
+    // Deletes the bundles left by destroyed envs, must be called before the isolate is disposed.
+    static void DeleteAll(v8::Isolate* isolate)
+    {
+        RefTracker::FinalizeAll(&GetIsolateData(isolate)->callbackBundles);
+    }
+
+    // The env the function was created in, or the env of the calling script once that env is destroyed.
+    inline JSVM_Env GetEnv(v8::Isolate* isolate)
+    {
+        return LIKELY(env != nullptr) ? env : GetContextEnv(isolate->GetEnteredOrMicrotaskContext());
+    }
+
+    JSVM_Callback cb;
+
+protected:
+    // Called for the bundles of an env when it is destroyed, and for the left ones when the VM is destroyed.
+    void Finalize() override
+    {
+        Unlink();
+        if (env == nullptr) {
+            delete this;
+            return;
+        }
+        Link(&GetIsolateData(env->isolate)->callbackBundles);
+        env = nullptr;
+    }
+
+private:
+    CallbackBundle(JSVM_Env env, JSVM_Callback cb) : cb(cb), env(env)
+    {
+        Link(&env->callbackBundleList);
+    }
+
+    ~CallbackBundle() override
+    {
+        Unlink();
+    }
+
+    static void WeakCallback(const v8::WeakCallbackInfo<CallbackBundle>& data)
+    {
+        CallbackBundle* bundle = data.GetParameter();
+        bundle->persistent.Reset();
+        delete bundle;
+    }
+
+    JSVM_Env env;
+    v8::Global<v8::External> persistent;
 };
 
 // Base class extended by classes that wrap V8 function and property callback
@@ -546,12 +898,14 @@ protected:
 
 class CallbackWrapperBase : public CallbackWrapper {
 public:
-    inline CallbackWrapperBase(const v8::FunctionCallbackInfo<v8::Value>& cbinfo, const size_t argsLength)
-        : CallbackWrapper(JsValueFromV8LocalValue(cbinfo.This()), argsLength, nullptr), cbinfo(cbinfo)
-    {
-        cb = static_cast<JSVM_Callback>(cbinfo.Data().As<v8::External>()->Value());
-        data = cb->data;
-    }
+    // env may be nullptr, in which case it is resolved from the current context.
+    inline CallbackWrapperBase(const v8::FunctionCallbackInfo<v8::Value>& cbinfo,
+                               const size_t argsLength,
+                               JSVM_Env env,
+                               JSVM_Callback cb)
+        : CallbackWrapper(JsValueFromV8LocalValue(cbinfo.This()), argsLength, cb->data), cbinfo(cbinfo), env(env),
+          cb(cb)
+    {}
 
 protected:
     inline const v8::FunctionCallbackInfo<v8::Value>& GetCbInfo()
@@ -564,8 +918,8 @@ protected:
         JSVM_CallbackInfo cbinfoWrapper = reinterpret_cast<JSVM_CallbackInfo>(static_cast<CallbackWrapper*>(this));
 
         // All other pointers we need are stored in `_bundle`
-        auto context = cbinfo.GetIsolate()->GetCurrentContext();
-        auto env = v8impl::GetContextEnv(context);
+        auto env = LIKELY(this->env != nullptr) ? this->env
+                                                 : v8impl::GetContextEnv(cbinfo.GetIsolate()->GetCurrentContext());
         auto func = cb->callback;
 
         JSVM_Value result = nullptr;
@@ -586,23 +940,49 @@ protected:
 
 private:
     const v8::FunctionCallbackInfo<v8::Value>& cbinfo;
+    JSVM_Env env;
     JSVM_Callback cb;
 };
 
 class FunctionCallbackWrapper : public CallbackWrapperBase {
 public:
+    // Used when the data is the bare callback, see CallbackBundle::New.
     static void Invoke(const v8::FunctionCallbackInfo<v8::Value>& info)
     {
-        FunctionCallbackWrapper cbwrapper(info);
+        FunctionCallbackWrapper cbwrapper(info, nullptr,
+                                          static_cast<JSVM_Callback>(info.Data().As<v8::External>()->Value()));
         cbwrapper.InvokeCallback();
     }
 
+    // Used when the data is a CallbackBundle, the env comes with the bundle.
+    static void InvokeBundled(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        CallbackBundle* bundle = CallbackBundle::From(info.Data());
+        FunctionCallbackWrapper cbwrapper(info, bundle->GetEnv(info.GetIsolate()), bundle->cb);
+        cbwrapper.InvokeCallback();
+    }
+
+    // Used for constructors of classes with wrapper fields, which are prepared before the callback runs.
+    template<v8::FunctionCallback invoke>
+    static void InvokeWithWrapperFields(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        if (info.IsConstructCall()) {
+            InitWrapperFields(info.GetIsolate(), info.This());
+        }
+        invoke(info);
+    }
+
+    static inline v8::FunctionCallback GetInvoke(JSVM_Env env, bool shared = false)
+    {
+        return !shared && CallbackBundle::IsBundled(env) ? InvokeBundled : Invoke;
+    }
+
     static inline JSVM_Status NewFunction(JSVM_Env env, JSVM_Callback cb, v8::Local<v8::Function>* result)
     {
         v8::Local<v8::Value> cbdata = v8impl::CallbackBundle::New(env, cb);
         RETURN_STATUS_IF_FALSE(env, !cbdata.IsEmpty(), JSVM_GENERIC_FAILURE);
 
-        v8::MaybeLocal<v8::Function> maybeFunction = v8::Function::New(env->context(), Invoke, cbdata);
+        v8::MaybeLocal<v8::Function> maybeFunction = v8::Function::New(env->context(), GetInvoke(env), cbdata);
         CHECK_MAYBE_EMPTY(env, maybeFunction, JSVM_GENERIC_FAILURE);
 
         *result = maybeFunction.ToLocalChecked();
@@ -612,17 +992,52 @@ public:
     static inline JSVM_Status NewTemplate(JSVM_Env env,
                                           JSVM_Callback cb,
                                           v8::Local<v8::FunctionTemplate>* result,
-                                          v8::Local<v8::Signature> sig = v8::Local<v8::Signature>())
+                                          v8::Local<v8::Signature> sig = v8::Local<v8::Signature>(),
+                                          bool shared = false)
     {
-        v8::Local<v8::Value> cbdata = v8impl::CallbackBundle::New(env, cb);
+        v8::Local<v8::Value> cbdata = v8impl::CallbackBundle::New(env, cb, shared);
+        RETURN_STATUS_IF_FALSE(env, !cbdata.IsEmpty(), JSVM_GENERIC_FAILURE);
+
+        *result = v8::FunctionTemplate::New(env->isolate, GetInvoke(env, shared), cbdata, sig);
+        return ClearLastError(env);
+    }
+
+    // Same as NewTemplate for a class constructor, which reserves the wrapper fields on its instances.
+    static inline JSVM_Status NewWrapperFieldTemplate(JSVM_Env env,
+                                                      JSVM_Callback cb,
+                                                      v8::Local<v8::FunctionTemplate>* result,
+                                                      bool shared = false)
+    {
+        v8::Local<v8::Value> cbdata = v8impl::CallbackBundle::New(env, cb, shared);
+        RETURN_STATUS_IF_FALSE(env, !cbdata.IsEmpty(), JSVM_GENERIC_FAILURE);
+
+        v8::FunctionCallback invoke = GetInvoke(env, shared) == InvokeBundled ? InvokeWithWrapperFields<InvokeBundled>
+                                                                              : InvokeWithWrapperFields<Invoke>;
+        *result = v8::FunctionTemplate::New(env->isolate, invoke, cbdata);
+        (*result)->InstanceTemplate()->SetInternalFieldCount(K_WRAPPER_FIELD_COUNT);
+        return ClearLastError(env);
+    }
+
+    // Same as NewTemplate, and additionally lets optimized code call cfunction
+    // directly. Functions with a fast call path can not be used as constructor.
+    static inline JSVM_Status NewFastTemplate(JSVM_Env env,
+                                              JSVM_Callback cb,
+                                              const v8::CFunction* cfunction,
+                                              v8::Local<v8::FunctionTemplate>* result,
+                                              v8::Local<v8::Signature> sig = v8::Local<v8::Signature>(),
+                                              bool shared = false)
+    {
+        v8::Local<v8::Value> cbdata = v8impl::CallbackBundle::New(env, cb, shared);
         RETURN_STATUS_IF_FALSE(env, !cbdata.IsEmpty(), JSVM_GENERIC_FAILURE);
 
-        *result = v8::FunctionTemplate::New(env->isolate, Invoke, cbdata, sig);
+        *result = v8::FunctionTemplate::New(env->isolate, GetInvoke(env, shared), cbdata, sig, 0,
+                                            v8::ConstructorBehavior::kThrow, v8::SideEffectType::kHasSideEffect,
+                                            cfunction);
         return ClearLastError(env);
     }
 
-    explicit FunctionCallbackWrapper(const v8::FunctionCallbackInfo<v8::Value>& cbinfo)
-        : CallbackWrapperBase(cbinfo, cbinfo.Length())
+    FunctionCallbackWrapper(const v8::FunctionCallbackInfo<v8::Value>& cbinfo, JSVM_Env env, JSVM_Callback cb)
+        : CallbackWrapperBase(cbinfo, cbinfo.Length(), env, cb)
     {}
 
     JSVM_Value GetNewTarget() override
@@ -661,6 +1076,269 @@ public:
     }
 };
 
+// Wraps the getter of a lazy data property, see JSVM_LAZY_DATA. V8 replaces
+// the property with the value returned by the getter on first access.
+class LazyDataPropertyWrapper : public CallbackWrapper {
+public:
+    // Used when the data is the bare callback, see CallbackBundle::New.
+    static void Invoke(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& info)
+    {
+        LazyDataPropertyWrapper cbwrapper(info, nullptr,
+                                          static_cast<JSVM_Callback>(info.Data().As<v8::External>()->Value()));
+        cbwrapper.InvokeCallback();
+    }
+
+    // Used when the data is a CallbackBundle, the env comes with the bundle.
+    static void InvokeBundled(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& info)
+    {
+        CallbackBundle* bundle = CallbackBundle::From(info.Data());
+        LazyDataPropertyWrapper cbwrapper(info, bundle->GetEnv(info.GetIsolate()), bundle->cb);
+        cbwrapper.InvokeCallback();
+    }
+
+    static inline v8::AccessorNameGetterCallback GetInvoke(JSVM_Env env, bool shared = false)
+    {
+        return !shared && CallbackBundle::IsBundled(env) ? InvokeBundled : Invoke;
+    }
+
+    LazyDataPropertyWrapper(const v8::PropertyCallbackInfo<v8::Value>& cbinfo, JSVM_Env env, JSVM_Callback cb)
+        : CallbackWrapper(JsValueFromV8LocalValue(cbinfo.This()), 0, cb->data), cbinfo(cbinfo), env(env), cb(cb)
+    {}
+
+    JSVM_Value GetNewTarget() override
+    {
+        return nullptr;
+    }
+
+    /*virtual*/
+    void GetArgs(JSVM_Value* buffer, size_t bufferLength) override
+    {
+        JSVM_Value undefined = v8impl::JsValueFromV8LocalValue(v8::Undefined(cbinfo.GetIsolate()));
+        for (size_t i = 0; i < bufferLength; i += 1) {
+            buffer[i] = undefined;
+        }
+    }
+
+    /*virtual*/
+    void SetReturnValue(JSVM_Value value) override
+    {
+        cbinfo.GetReturnValue().Set(v8impl::V8LocalValueFromJsValue(value));
+    }
+
+private:
+    void InvokeCallback()
+    {
+        JSVM_CallbackInfo cbinfoWrapper = reinterpret_cast<JSVM_CallbackInfo>(static_cast<CallbackWrapper*>(this));
+        auto env = LIKELY(this->env != nullptr) ? this->env
+                                                 : v8impl::GetContextEnv(cbinfo.GetIsolate()->GetCurrentContext());
+        auto func = cb->callback;
+
+        JSVM_Value result = nullptr;
+        bool exceptionOccurred = false;
+        env->CallIntoModule([&](JSVM_Env env) { result = func(env, cbinfoWrapper); },
+                            [&](JSVM_Env env, v8::Local<v8::Value> value) {
+                                exceptionOccurred = true;
+                                if (env->IsTerminatedOrTerminating()) {
+                                    return;
+                                }
+                                env->isolate->ThrowException(value);
+                            });
+
+        if (!exceptionOccurred && (result != nullptr)) {
+            this->SetReturnValue(result);
+        }
+    }
+
+    const v8::PropertyCallbackInfo<v8::Value>& cbinfo;
+    JSVM_Env env;
+    JSVM_Callback cb;
+};
+
+inline bool IsLazyDataProperty(const JSVM_PropertyDescriptor* p)
+{
+    return (p->attributes & JSVM_LAZY_DATA) != 0;
+}
+
+// Lazy data properties take their value from the getter, a setter is not allowed.
+inline JSVM_Status SetLazyDataProperty(JSVM_Env env,
+                                       v8::Local<v8::Template> tpl,
+                                       v8::Local<v8::Name> propertyName,
+                                       const JSVM_PropertyDescriptor* p,
+                                       bool shared = false)
+{
+    RETURN_STATUS_IF_FALSE(env, p->getter != nullptr && p->setter == nullptr, JSVM_INVALID_ARG);
+    v8::Local<v8::Value> cbdata = CallbackBundle::New(env, p->getter, shared);
+    RETURN_STATUS_IF_FALSE(env, !cbdata.IsEmpty(), JSVM_GENERIC_FAILURE);
+
+    tpl->SetLazyDataProperty(propertyName, LazyDataPropertyWrapper::GetInvoke(env, shared), cbdata,
+                             V8PropertyAttributesFromDescriptor(p));
+    return JSVM_OK;
+}
+
+// Owns the type information of a fast call function. V8 only keeps raw
+// pointers to it, so it is released together with the function created
+// from it, or interned in the isolate for class methods.
+class FastCallInfo {
+public:
+    static JSVM_Status New(JSVM_Env env, const JSVM_FastCallbackStruct* cb, std::unique_ptr<FastCallInfo>* result)
+    {
+        RETURN_STATUS_IF_FALSE(env, cb->callback.callback != nullptr, JSVM_INVALID_ARG);
+        RETURN_STATUS_IF_FALSE(env, cb->fastCallback != nullptr, JSVM_INVALID_ARG);
+        RETURN_STATUS_IF_FALSE(env, cb->argc == 0 || cb->argTypes != nullptr, JSVM_INVALID_ARG);
+        RETURN_STATUS_IF_FALSE(env, cb->argc <= MAX_ARGC, JSVM_INVALID_ARG);
+
+        v8::CTypeInfo returnInfo(v8::CTypeInfo::Type::kVoid);
+        RETURN_STATUS_IF_FALSE(env, ToCTypeInfo(cb->returnType, &returnInfo), JSVM_INVALID_ARG);
+
+        std::vector<v8::CTypeInfo> argInfo;
+        argInfo.reserve(cb->argc + 1);
+        // The receiver is always passed as the first argument.
+        argInfo.emplace_back(v8::CTypeInfo::Type::kV8Value);
+        for (size_t i = 0; i < cb->argc; i++) {
+            v8::CTypeInfo info(v8::CTypeInfo::Type::kVoid);
+            bool isValid = cb->argTypes[i] != JSVM_FAST_VOID && ToCTypeInfo(cb->argTypes[i], &info);
+            RETURN_STATUS_IF_FALSE(env, isValid, JSVM_INVALID_ARG);
+            argInfo.push_back(info);
+        }
+
+        result->reset(new FastCallInfo(cb->fastCallback, returnInfo, std::move(argInfo)));
+        return JSVM_OK;
+    }
+
+    // Returns the info of cb owned by the isolate, shared by all methods with the same fast function and signature.
+    static JSVM_Status Intern(JSVM_Env env, const JSVM_FastCallbackStruct* cb, const FastCallInfo** result);
+
+    static void Finalize(JSVM_Env env, void* finalizeData, void* finalizeHint)
+    {
+        delete static_cast<FastCallInfo*>(finalizeData);
+    }
+
+    const v8::CFunction* GetCFunction() const
+    {
+        return &cfunction;
+    }
+
+    std::vector<uintptr_t> Signature() const
+    {
+        std::vector<uintptr_t> signature;
+        signature.reserve(argInfo.size() + 2);
+        signature.push_back(reinterpret_cast<uintptr_t>(cfunction.GetAddress()));
+        signature.push_back(static_cast<uintptr_t>(returnInfo.GetType()));
+        for (const auto& info : argInfo) {
+            signature.push_back(static_cast<uintptr_t>(info.GetType()));
+        }
+        return signature;
+    }
+
+private:
+    static constexpr size_t MAX_ARGC = 32;
+
+    FastCallInfo(const void* address, v8::CTypeInfo returnInfo, std::vector<v8::CTypeInfo>&& argInfo)
+        : returnInfo(returnInfo), argInfo(std::move(argInfo)),
+          functionInfo(this->returnInfo, this->argInfo.size(), this->argInfo.data()),
+          cfunction(address, &functionInfo)
+    {}
+
+    static bool ToCTypeInfo(JSVM_FastCallType type, v8::CTypeInfo* result)
+    {
+        v8::CTypeInfo::Type v8Type;
+        switch (type) {
+            case JSVM_FAST_VOID:
+                v8Type = v8::CTypeInfo::Type::kVoid;
+                break;
+            case JSVM_FAST_BOOL:
+                v8Type = v8::CTypeInfo::Type::kBool;
+                break;
+            case JSVM_FAST_INT32:
+                v8Type = v8::CTypeInfo::Type::kInt32;
+                break;
+            case JSVM_FAST_UINT32:
+                v8Type = v8::CTypeInfo::Type::kUint32;
+                break;
+            case JSVM_FAST_INT64:
+                v8Type = v8::CTypeInfo::Type::kInt64;
+                break;
+            case JSVM_FAST_UINT64:
+                v8Type = v8::CTypeInfo::Type::kUint64;
+                break;
+            case JSVM_FAST_FLOAT32:
+                v8Type = v8::CTypeInfo::Type::kFloat32;
+                break;
+            case JSVM_FAST_FLOAT64:
+                v8Type = v8::CTypeInfo::Type::kFloat64;
+                break;
+            default:
+                return false;
+        }
+        *result = v8::CTypeInfo(v8Type);
+        return true;
+    }
+
+    const v8::CTypeInfo returnInfo;
+    const std::vector<v8::CTypeInfo> argInfo;
+    const v8::CFunctionInfo functionInfo;
+    const v8::CFunction cfunction;
+};
+
+JSVM_Status FastCallInfo::Intern(JSVM_Env env, const JSVM_FastCallbackStruct* cb, const FastCallInfo** result)
+{
+    std::unique_ptr<FastCallInfo> info;
+    STATUS_CALL(New(env, cb, &info));
+    auto& fastCalls = GetIsolateData(env->isolate)->fastCalls;
+    auto signature = info->Signature();
+    auto it = fastCalls.find(signature);
+    if (it == fastCalls.end()) {
+        it = fastCalls.emplace(std::move(signature), std::move(info)).first;
+    }
+    *result = it->second.get();
+    return JSVM_OK;
+}
+
+// Creates the template of a method descriptor. The type information of a
+// fast call method is handed over to fastCalls, the caller decides its lifetime.
+// Without fastCalls, as for class methods, it is interned in the isolate.
+inline JSVM_Status NewMethodTemplate(JSVM_Env env,
+                                     const JSVM_PropertyDescriptor* p,
+                                     std::vector<std::unique_ptr<FastCallInfo>>* fastCalls,
+                                     v8::Local<v8::FunctionTemplate>* result,
+                                     v8::Local<v8::Signature> sig = v8::Local<v8::Signature>(),
+                                     bool shared = false)
+{
+    if ((p->attributes & JSVM_FAST_CALL) == 0) {
+        return FunctionCallbackWrapper::NewTemplate(env, p->method, result, sig, shared);
+    }
+
+    auto cb = reinterpret_cast<const JSVM_FastCallbackStruct*>(p->method);
+    if (fastCalls == nullptr) {
+        const FastCallInfo* info = nullptr;
+        STATUS_CALL(FastCallInfo::Intern(env, cb, &info));
+        return FunctionCallbackWrapper::NewFastTemplate(env, p->method, info->GetCFunction(), result, sig, shared);
+    }
+
+    std::unique_ptr<FastCallInfo> info;
+    STATUS_CALL(FastCallInfo::New(env, cb, &info));
+    STATUS_CALL(FunctionCallbackWrapper::NewFastTemplate(env, p->method, info->GetCFunction(), result, sig, shared));
+    fastCalls->push_back(std::move(info));
+    return JSVM_OK;
+}
+
+// Ties the lifetime of the fast call type information to value, which must be
+// the only function instantiated from the templates using it.
+inline void AttachFastCalls(JSVM_Env env,
+                            v8::Local<v8::Value> value,
+                            std::vector<std::unique_ptr<FastCallInfo>>& fastCalls)
+{
+    for (auto& info : fastCalls) {
+        v8impl::RuntimeReference::New(env, value, FastCallInfo::Finalize, info.release(), nullptr);
+    }
+    fastCalls.clear();
+}
+
+IsolateData::~IsolateData()
+{
+    delete blob;
+}
+
 template<typename T>
 class PropertyCallbackWrapperBase : public CallbackWrapper {
 public:
@@ -685,8 +1363,7 @@ public:
 
     void NameSetterInvokeCallback()
     {
-        auto context = cbinfo.GetIsolate()->GetCurrentContext();
-        auto env = v8impl::GetContextEnv(context);
+        auto env = propertyHandler->env;
         auto setterCb = propertyHandler->namedSetterCallback;
 
         JSVM_Value innerData = nullptr;
@@ -724,8 +1401,7 @@ public:
     }
     void IndexSetterInvokeCallback()
     {
-        auto context = cbinfo.GetIsolate()->GetCurrentContext();
-        auto env = v8impl::GetContextEnv(context);
+        auto env = propertyHandler->env;
         auto indexSetterCb = propertyHandler->indexedSetterCallback;
 
         JSVM_Value innerData = nullptr;
@@ -765,8 +1441,7 @@ public:
 protected:
     inline void NameGetterInvokeCallback()
     {
-        auto context = cbinfo.GetIsolate()->GetCurrentContext();
-        auto env = v8impl::GetContextEnv(context);
+        auto env = propertyHandler->env;
         auto getterCb = propertyHandler->namedGetterCallback;
 
         JSVM_Value innerData = nullptr;
@@ -802,8 +1477,7 @@ protected:
 
     void NameDeleterInvokeCallback()
     {
-        auto context = cbinfo.GetIsolate()->GetCurrentContext();
-        auto env = v8impl::GetContextEnv(context);
+        auto env = propertyHandler->env;
         auto deleterCb = propertyHandler->nameDeleterCallback;
 
         JSVM_Value innerData = nullptr;
@@ -842,8 +1516,7 @@ protected:
 
     void NameEnumeratorInvokeCallback()
     {
-        auto context = cbinfo.GetIsolate()->GetCurrentContext();
-        auto env = v8impl::GetContextEnv(context);
+        auto env = propertyHandler->env;
         auto enumeratorCb = propertyHandler->namedEnumeratorCallback;
 
         JSVM_Value innerData = nullptr;
@@ -880,8 +1553,7 @@ protected:
 
     void IndexGetterInvokeCallback()
     {
-        auto context = cbinfo.GetIsolate()->GetCurrentContext();
-        auto env = v8impl::GetContextEnv(context);
+        auto env = propertyHandler->env;
         auto indexGetterCb = propertyHandler->indexedGetterCallback;
 
         JSVM_Value innerData = nullptr;
@@ -918,8 +1590,7 @@ protected:
 
     void IndexDeleterInvokeCallback()
     {
-        auto context = cbinfo.GetIsolate()->GetCurrentContext();
-        auto env = v8impl::GetContextEnv(context);
+        auto env = propertyHandler->env;
         auto indexDeleterCb = propertyHandler->indexedDeleterCallback;
 
         JSVM_Value innerData = nullptr;
@@ -958,8 +1629,7 @@ protected:
 
     void IndexEnumeratorInvokeCallback()
     {
-        auto context = cbinfo.GetIsolate()->GetCurrentContext();
-        auto env = v8impl::GetContextEnv(context);
+        auto env = propertyHandler->env;
         auto enumeratorCb = propertyHandler->indexedEnumeratorCallback;
 
         JSVM_Value innerData = nullptr;
@@ -1076,13 +1746,191 @@ public:
         : PropertyCallbackWrapperBase<T>(index, v8::Local<v8::Name>(), value, cbinfo, 0), cbinfo(cbinfo)
     {}
 
-    /*virtual*/
-    void SetReturnValue(JSVM_Value value) override;
+    /*virtual*/
+    void SetReturnValue(JSVM_Value value) override;
+
+protected:
+    const v8::PropertyCallbackInfo<T>& cbinfo;
+};
+
+// Indexed interceptors of classes defined with JSVM_DEFINE_CLASS_WITH_NATIVE_ELEMENTS. Elements are read and
+// written in the native memory that the accessor returns for the wrapped native object, without calling into
+// the module. Indices out of range fall through to the object.
+template<typename ElementType>
+class NativeElementsInterceptor {
+public:
+    static void Configure(v8::Isolate* isolate,
+                          v8::Local<v8::ObjectTemplate> tpl,
+                          JSVM_NativeElementsAccessor accessor,
+                          bool readOnly)
+    {
+        v8::IndexedPropertyHandlerConfiguration config(nullptr);
+        config.getter = Getter;
+        config.setter = readOnly ? ReadOnlySetter : Setter;
+        config.query = readOnly ? ReadOnlyQuery : Query;
+        config.deleter = Deleter;
+        config.enumerator = Enumerator;
+        config.data = v8::External::New(isolate, reinterpret_cast<void*>(accessor));
+        tpl->SetHandler(config);
+    }
+
+private:
+    template<typename T>
+    static bool GetElements(const v8::PropertyCallbackInfo<T>& info, ElementType** elements, size_t* length)
+    {
+        auto accessor = reinterpret_cast<JSVM_NativeElementsAccessor>(info.Data().template As<v8::External>()->Value());
+        void* native = GetWrappedNative(info.GetIsolate(), info.This());
+        void* data = nullptr;
+        if (native == nullptr || !accessor(native, &data, length)) {
+            return false;
+        }
+        *elements = static_cast<ElementType*>(data);
+        return true;
+    }
+
+    template<typename T>
+    static bool InRange(const v8::PropertyCallbackInfo<T>& info, uint32_t index)
+    {
+        ElementType* elements = nullptr;
+        size_t length = 0;
+        return GetElements(info, &elements, &length) && index < length;
+    }
+
+    static v8::Intercepted Getter(uint32_t index, const v8::PropertyCallbackInfo<v8::Value>& info)
+    {
+        ElementType* elements = nullptr;
+        size_t length = 0;
+        if (!GetElements(info, &elements, &length) || index >= length) {
+            return v8::Intercepted::kNo;
+        }
+        info.GetReturnValue().Set(elements[index]);
+        return v8::Intercepted::kYes;
+    }
+
+    // Numbers are converted like stores to typed arrays. Returns false if the conversion threw.
+    static bool ToElement(v8::Isolate* isolate, v8::Local<v8::Value> value, ElementType* result)
+    {
+        v8::Local<v8::Context> context = isolate->GetCurrentContext();
+        if constexpr (std::is_same_v<ElementType, double>) {
+            if (value->IsNumber()) {
+                *result = value.As<v8::Number>()->Value();
+                return true;
+            }
+            return value->NumberValue(context).To(result);
+        } else if constexpr (std::is_same_v<ElementType, int32_t>) {
+            if (value->IsInt32()) {
+                *result = value.As<v8::Int32>()->Value();
+                return true;
+            }
+            return value->Int32Value(context).To(result);
+        } else {
+            uint32_t number = 0;
+            if (!value->Uint32Value(context).To(&number)) {
+                return false;
+            }
+            *result = static_cast<ElementType>(number);
+            return true;
+        }
+    }
+
+    static v8::Intercepted Setter(uint32_t index,
+                                  v8::Local<v8::Value> value,
+                                  const v8::PropertyCallbackInfo<void>& info)
+    {
+        if (!InRange(info, index)) {
+            return v8::Intercepted::kNo;
+        }
+        // The conversion may run JavaScript, like valueOf, which can resize or free the native array. So the
+        // array is located again after it, and the store is dropped if index is no longer within it. If the
+        // conversion throws, the element is kept.
+        ElementType element {};
+        if (!ToElement(info.GetIsolate(), value, &element)) {
+            return v8::Intercepted::kYes;
+        }
+        ElementType* elements = nullptr;
+        size_t length = 0;
+        if (GetElements(info, &elements, &length) && index < length) {
+            elements[index] = element;
+        }
+        return v8::Intercepted::kYes;
+    }
+
+    static v8::Intercepted ReadOnlySetter(uint32_t index,
+                                          v8::Local<v8::Value> value,
+                                          const v8::PropertyCallbackInfo<void>& info)
+    {
+        // Writes to elements are ignored, as for frozen typed arrays.
+        return InRange(info, index) ? v8::Intercepted::kYes : v8::Intercepted::kNo;
+    }
+
+    static v8::Intercepted Query(uint32_t index, const v8::PropertyCallbackInfo<v8::Integer>& info)
+    {
+        if (!InRange(info, index)) {
+            return v8::Intercepted::kNo;
+        }
+        info.GetReturnValue().Set(static_cast<int32_t>(v8::DontDelete));
+        return v8::Intercepted::kYes;
+    }
+
+    static v8::Intercepted ReadOnlyQuery(uint32_t index, const v8::PropertyCallbackInfo<v8::Integer>& info)
+    {
+        if (!InRange(info, index)) {
+            return v8::Intercepted::kNo;
+        }
+        info.GetReturnValue().Set(static_cast<int32_t>(v8::DontDelete | v8::ReadOnly));
+        return v8::Intercepted::kYes;
+    }
+
+    static v8::Intercepted Deleter(uint32_t index, const v8::PropertyCallbackInfo<v8::Boolean>& info)
+    {
+        if (!InRange(info, index)) {
+            return v8::Intercepted::kNo;
+        }
+        info.GetReturnValue().Set(false);
+        return v8::Intercepted::kYes;
+    }
 
-protected:
-    const v8::PropertyCallbackInfo<T>& cbinfo;
+    static void Enumerator(const v8::PropertyCallbackInfo<v8::Array>& info)
+    {
+        ElementType* elements = nullptr;
+        size_t length = 0;
+        if (!GetElements(info, &elements, &length)) {
+            return;
+        }
+        // Longer arrays can not be created, the remaining elements are still accessible by index.
+        length = std::min(length, K_MAX_ARRAY_ELEMENTS_LENGTH);
+        v8::Isolate* isolate = info.GetIsolate();
+        std::vector<v8::Local<v8::Value>> indices(length);
+        for (size_t i = 0; i < length; ++i) {
+            indices[i] = v8::Integer::NewFromUnsigned(isolate, static_cast<uint32_t>(i));
+        }
+        info.GetReturnValue().Set(v8::Array::New(isolate, indices.data(), indices.size()));
+    }
 };
 
+// Installs the indexed interceptor of elements, returns false if elements is not valid.
+bool SetNativeElementsHandler(v8::Isolate* isolate,
+                              v8::Local<v8::ObjectTemplate> tpl,
+                              const JSVM_NativeElements* elements)
+{
+    if (elements == nullptr || elements->accessor == nullptr) {
+        return false;
+    }
+    switch (elements->type) {
+        case JSVM_NATIVE_ELEMENT_INT32:
+            NativeElementsInterceptor<int32_t>::Configure(isolate, tpl, elements->accessor, elements->readOnly);
+            return true;
+        case JSVM_NATIVE_ELEMENT_DOUBLE:
+            NativeElementsInterceptor<double>::Configure(isolate, tpl, elements->accessor, elements->readOnly);
+            return true;
+        case JSVM_NATIVE_ELEMENT_UINT8:
+            NativeElementsInterceptor<uint8_t>::Configure(isolate, tpl, elements->accessor, elements->readOnly);
+            return true;
+        default:
+            return false;
+    }
+}
+
 template<>
 void PropertyCallbackWrapper<void>::SetReturnValue(JSVM_Value value)
 {
@@ -1096,6 +1944,98 @@ void PropertyCallbackWrapper<T>::SetReturnValue(JSVM_Value value)
     cbinfo.GetReturnValue().Set(val);
 }
 
+// Decodes one argument for OH_JSVM_GetCbTypedArgs, follows the conversion
+// rules of the matching OH_JSVM_GetValue* API. Returns false on type mismatch.
+bool DecodeTypedArg(JSVM_Env env, v8::Local<v8::Value> val, const JSVM_ArgSpec& spec)
+{
+    // Empty context: https://github.com/nodejs/node/issues/14379
+    v8::Local<v8::Context> context;
+    switch (spec.type) {
+        case JSVM_ARG_INT32:
+            if (val->IsInt32()) {
+                *static_cast<int32_t*>(spec.value) = val.As<v8::Int32>()->Value();
+            } else if (val->IsNumber()) {
+                *static_cast<int32_t*>(spec.value) = val->Int32Value(context).FromJust();
+            } else {
+                return false;
+            }
+            return true;
+        case JSVM_ARG_UINT32:
+            if (val->IsUint32()) {
+                *static_cast<uint32_t*>(spec.value) = val.As<v8::Uint32>()->Value();
+            } else if (val->IsNumber()) {
+                *static_cast<uint32_t*>(spec.value) = val->Uint32Value(context).FromJust();
+            } else {
+                return false;
+            }
+            return true;
+        case JSVM_ARG_INT64:
+            if (val->IsInt32()) {
+                *static_cast<int64_t*>(spec.value) = val.As<v8::Int32>()->Value();
+            } else if (val->IsNumber()) {
+                // Non-finite values are converted to 0, see OH_JSVM_GetValueInt64.
+                bool isFinite = std::isfinite(val.As<v8::Number>()->Value());
+                *static_cast<int64_t*>(spec.value) = isFinite ? val->IntegerValue(context).FromJust() : 0;
+            } else {
+                return false;
+            }
+            return true;
+        case JSVM_ARG_DOUBLE:
+            if (!val->IsNumber()) {
+                return false;
+            }
+            *static_cast<double*>(spec.value) = val.As<v8::Number>()->Value();
+            return true;
+        case JSVM_ARG_BOOL:
+            if (!val->IsBoolean()) {
+                return false;
+            }
+            *static_cast<bool*>(spec.value) = val.As<v8::Boolean>()->Value();
+            return true;
+        case JSVM_ARG_STRING_UTF8: {
+            if (!val->IsString()) {
+                return false;
+            }
+            size_t copied = 0;
+            if (spec.bufsize != 0) {
+                char* buf = static_cast<char*>(spec.value);
+#if JSVM_V8_NEW_VERSION
+                copied = val.As<v8::String>()->WriteUtf8V2(env->isolate, buf, spec.bufsize - 1,
+                                                           v8::String::WriteFlags::kReplaceInvalidUtf8);
+#else
+                copied = val.As<v8::String>()->WriteUtf8(env->isolate, buf, spec.bufsize - 1, nullptr,
+                                                         v8::String::REPLACE_INVALID_UTF8 |
+                                                             v8::String::NO_NULL_TERMINATION);
+#endif
+                buf[copied] = '\0';
+            }
+            if (spec.length != nullptr) {
+                *spec.length = copied;
+            }
+            return true;
+        }
+        case JSVM_ARG_EXTERNAL:
+            if (!val->IsExternal()) {
+                return false;
+            }
+            *static_cast<void**>(spec.value) = v8impl::ExternalWrapper::From(val.As<v8::External>())->Data();
+            return true;
+        case JSVM_ARG_TYPEDARRAY: {
+            if (!val->IsTypedArray()) {
+                return false;
+            }
+            v8::Local<v8::TypedArray> array = val.As<v8::TypedArray>();
+            *static_cast<void**>(spec.value) = static_cast<uint8_t*>(array->Buffer()->Data()) + array->ByteOffset();
+            if (spec.length != nullptr) {
+                *spec.length = array->Length();
+            }
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
 JSVM_Status Wrap(JSVM_Env env, JSVM_Value jsObject, void *nativeObject, JSVM_Finalize finalizeCb, void *finalizeHint,
     JSVM_Ref *result)
 {
@@ -1110,6 +2050,23 @@ JSVM_Status Wrap(JSVM_Env env, JSVM_Value jsObject, void *nativeObject, JSVM_Fin
     if (obj->IsExternal()) {
         RETURN_STATUS_IF_FALSE(
             env, !v8impl::ExternalWrapper::From(obj.As<v8::External>())->HasWrapper(), JSVM_INVALID_ARG);
+    } else if (HasWrapperFields(obj)) {
+        RETURN_STATUS_IF_FALSE(env, obj->GetAlignedPointerFromInternalField(K_WRAPPER_DATA_FIELD) == nullptr,
+                               JSVM_INVALID_ARG);
+        // The fields take aligned pointers only, and a null field means the object is not wrapped.
+        RETURN_STATUS_IF_FALSE(env, nativeObject != nullptr && (reinterpret_cast<uintptr_t>(nativeObject) & 1) == 0,
+                               JSVM_INVALID_ARG);
+        // Without a finalizer, the fields alone keep the native object, so no reference is needed.
+        RuntimeReference* reference = nullptr;
+        if (finalizeCb != nullptr) {
+            reference = v8impl::RuntimeReference::New(env, obj, finalizeCb, nativeObject, finalizeHint);
+        }
+        if (result != nullptr) {
+            *result = reinterpret_cast<JSVM_Ref>(v8impl::UserReference::New(env, obj, 0));
+        }
+        obj->SetAlignedPointerInInternalField(K_WRAPPER_DATA_FIELD, nativeObject);
+        obj->SetAlignedPointerInInternalField(K_WRAPPER_REFERENCE_FIELD, reference);
+        return JSVM_OK;
     } else {
         // If we've already wrapped this object, we error out.
         RETURN_STATUS_IF_FALSE(
@@ -1179,6 +2136,11 @@ JSVM_Status OH_JSVM_Init(const JSVM_InitOptions* options)
 
         const auto cb = v8impl::FunctionCallbackWrapper::Invoke;
         v8impl::externalReferenceRegistry.push_back((intptr_t)cb);
+        const auto wrapperFieldCb =
+            v8impl::FunctionCallbackWrapper::InvokeWithWrapperFields<v8impl::FunctionCallbackWrapper::Invoke>;
+        v8impl::externalReferenceRegistry.push_back((intptr_t)wrapperFieldCb);
+        const auto lazyDataCb = v8impl::LazyDataPropertyWrapper::Invoke;
+        v8impl::externalReferenceRegistry.push_back((intptr_t)lazyDataCb);
         if (auto p = options ? options->externalReferences : nullptr) {
             for (; *p != 0; p++) {
                 v8impl::externalReferenceRegistry.push_back(*p);
@@ -1259,6 +2221,9 @@ JSVM_Status OH_JSVM_DestroyVM(JSVM_VM vm)
     if (handlerPool != nullptr && handlerPool->heapThresholdCallback != nullptr) {
         isolate->RemoveGCPrologueCallback(OnGCWithHeapThreshold, nullptr);
     }
+    if (data != nullptr) {
+        v8impl::CallbackBundle::DeleteAll(isolate);
+    }
     if (creator != nullptr) {
         delete creator;
     } else {
@@ -1365,7 +2330,9 @@ JSVM_Status OH_JSVM_CreateEnv(JSVM_VM vm,
 
         v8::PropertyAttribute attributes = v8impl::V8PropertyAttributesFromDescriptor(p);
 
-        if (p->getter != nullptr || p->setter != nullptr) {
+        if (v8impl::IsLazyDataProperty(p)) {
+            STATUS_CALL(v8impl::SetLazyDataProperty(env, globalTemplate, propertyName, p));
+        } else if (p->getter != nullptr || p->setter != nullptr) {
             v8::Local<v8::FunctionTemplate> getterTpl;
             v8::Local<v8::FunctionTemplate> setterTpl;
             if (p->getter != nullptr) {
@@ -1820,6 +2787,48 @@ JSVM_Status OH_JSVM_JsonParse(JSVM_Env env, JSVM_Value json_string, JSVM_Value*
     return GET_RETURN_STATUS(env);
 }
 
+JSVM_Status OH_JSVM_JsonParseUtf8(JSVM_Env env, const char* data, size_t length, JSVM_Value* result)
+{
+    JSVM_API_ENTER(env, K_JSVM_ACCESS_JS_RUNTIME);
+    CHECK_NEW_STRING_ARGS(env, data, length, result);
+
+    size_t byteLength = length == JSVM_AUTO_LENGTH ? strlen(data) : length;
+    auto maybeSource = v8impl::NewStringFromUtf8(env->isolate, data, byteLength);
+    CHECK_MAYBE_EMPTY(env, maybeSource, JSVM_GENERIC_FAILURE);
+
+    auto maybe = v8::JSON::Parse(env->context(), maybeSource.ToLocalChecked());
+    CHECK_MAYBE_EMPTY_WITH_PREAMBLE(env, maybe, JSVM_GENERIC_FAILURE);
+    *result = v8impl::JsValueFromV8LocalValue(maybe.ToLocalChecked());
+    ADD_VAL_TO_SCOPE_CHECK(env, *result);
+
+    return GET_RETURN_STATUS(env);
+}
+
+JSVM_Status OH_JSVM_JsonParseExternalLatin1(JSVM_Env env,
+                                            char* data,
+                                            size_t length,
+                                            JSVM_Finalize finalizeCallback,
+                                            void* finalizeHint,
+                                            JSVM_Value* result,
+                                            bool* copied)
+{
+    JSVM_API_ENTER(env, K_JSVM_ACCESS_JS_RUNTIME);
+    CHECK_ARG(env, result);
+    CHECK_ARG(env, copied);
+
+    JSVM_Value source = nullptr;
+    STATUS_CALL(OH_JSVM_CreateExternalStringLatin1(env, data, length, finalizeCallback, finalizeHint, &source,
+                                                   copied));
+
+    v8::Local<v8::String> str = v8impl::V8LocalValueFromJsValue(source).As<v8::String>();
+    auto maybe = v8::JSON::Parse(env->context(), str);
+    CHECK_MAYBE_EMPTY_WITH_PREAMBLE(env, maybe, JSVM_GENERIC_FAILURE);
+    *result = v8impl::JsValueFromV8LocalValue(maybe.ToLocalChecked());
+    ADD_VAL_TO_SCOPE_CHECK(env, *result);
+
+    return GET_RETURN_STATUS(env);
+}
+
 JSVM_Status OH_JSVM_JsonStringify(JSVM_Env env, JSVM_Value json_object, JSVM_Value* result)
 {
     JSVM_API_ENTER(env, K_JSVM_ACCESS_JS_RUNTIME);
@@ -1836,6 +2845,29 @@ JSVM_Status OH_JSVM_JsonStringify(JSVM_Env env, JSVM_Value json_object, JSVM_Val
     return GET_RETURN_STATUS(env);
 }
 
+JSVM_Status OH_JSVM_JsonStringifyToStream(JSVM_Env env,
+                                          JSVM_Value jsonObject,
+                                          JSVM_OutputStream stream,
+                                          void* streamData)
+{
+    JSVM_API_ENTER(env, K_JSVM_ACCESS_JS_RUNTIME);
+    CHECK_ARG(env, jsonObject);
+    CHECK_ARG(env, stream);
+    CHECK_SCOPE(env, jsonObject);
+
+    v8::HandleScope scope(env->isolate);
+    v8::Local<v8::Value> val = v8impl::V8LocalValueFromJsValue(jsonObject);
+    auto maybe = v8::JSON::Stringify(env->context(), val);
+    CHECK_MAYBE_EMPTY_WITH_PREAMBLE(env, maybe, JSVM_GENERIC_FAILURE);
+
+    // The text is encoded chunk by chunk from the string, rather than copied out as a whole.
+    v8impl::OutputStream os(stream, streamData);
+    RETURN_STATUS_IF_FALSE(env, v8impl::WriteUtf8ToStream(env->isolate, maybe.ToLocalChecked(), &os),
+                           JSVM_CANCELLED);
+    os.EndOfStream();
+    return GET_RETURN_STATUS(env);
+}
+
 JSVM_Status OH_JSVM_CreateSnapshot(JSVM_VM vm,
                                    size_t contextCount,
                                    const JSVM_Env* contexts,
@@ -2099,6 +3131,41 @@ JSVM_Status OH_JSVM_CreateFunction(JSVM_Env env,
     return GET_RETURN_STATUS(env);
 }
 
+JSVM_Status OH_JSVM_CreateFunctionWithFastCall(JSVM_Env env,
+                                               const char* utf8name,
+                                               size_t length,
+                                               JSVM_FastCallback cb,
+                                               JSVM_Value* result)
+{
+    JSVM_API_ENTER(env, K_JSVM_ACCESS_JS_RUNTIME);
+    CHECK_ARG(env, result);
+    CHECK_ARG(env, cb);
+
+    std::unique_ptr<v8impl::FastCallInfo> info;
+    STATUS_CALL(v8impl::FastCallInfo::New(env, cb, &info));
+
+    v8::EscapableHandleScope scope(env->isolate);
+    v8::Local<v8::FunctionTemplate> tpl;
+    STATUS_CALL(v8impl::FunctionCallbackWrapper::NewFastTemplate(env, &cb->callback, info->GetCFunction(), &tpl));
+
+    v8::MaybeLocal<v8::Function> maybeFunction = tpl->GetFunction(env->context());
+    CHECK_MAYBE_EMPTY(env, maybeFunction, JSVM_GENERIC_FAILURE);
+    v8::Local<v8::Function> returnValue = scope.Escape(maybeFunction.ToLocalChecked());
+
+    if (utf8name != nullptr) {
+        v8::Local<v8::String> nameString;
+        CHECK_NEW_FROM_UTF8_LEN(env, nameString, utf8name, length);
+        returnValue->SetName(nameString);
+    }
+
+    v8impl::RuntimeReference::New(env, returnValue, v8impl::FastCallInfo::Finalize, info.release(), nullptr);
+
+    *result = v8impl::JsValueFromV8LocalValue(returnValue);
+    ADD_VAL_TO_SCOPE_CHECK(env, *result);
+
+    return GET_RETURN_STATUS(env);
+}
+
 JSVM_Status OH_JSVM_CreateFunctionWithScript(JSVM_Env env,
                                              const char* funcName,
                                              size_t length,
@@ -2189,8 +3256,11 @@ JSVM_Status OH_JSVM_DefineClass(JSVM_Env env,
         // This code is similar to that in OH_JSVM_DefineProperties(); the
         // difference is it applies to a template instead of an object,
         // and preferred PropertyAttribute for lack of PropertyDescriptor
-        // support on ObjectTemplate.
-        if (p->getter != nullptr || p->setter != nullptr) {
+        // support on ObjectTemplate. Lazy data properties are set on the
+        // instances, so that each of them computes its own value.
+        if (v8impl::IsLazyDataProperty(p)) {
+            STATUS_CALL(v8impl::SetLazyDataProperty(env, tpl->InstanceTemplate(), propertyName, p));
+        } else if (p->getter != nullptr || p->setter != nullptr) {
             v8::Local<v8::FunctionTemplate> getterTpl;
             v8::Local<v8::FunctionTemplate> setterTpl;
             if (p->getter != nullptr) {
@@ -2204,10 +3274,9 @@ JSVM_Status OH_JSVM_DefineClass(JSVM_Env env,
         } else if (p->method != nullptr) {
             v8::Local<v8::FunctionTemplate> t;
             if (p->attributes & JSVM_NO_RECEIVER_CHECK) {
-                STATUS_CALL(v8impl::FunctionCallbackWrapper::NewTemplate(env, p->method, &t));
+                STATUS_CALL(v8impl::NewMethodTemplate(env, p, nullptr, &t));
             } else {
-                STATUS_CALL(
-                    v8impl::FunctionCallbackWrapper::NewTemplate(env, p->method, &t, v8::Signature::New(isolate, tpl)));
+                STATUS_CALL(v8impl::NewMethodTemplate(env, p, nullptr, &t, v8::Signature::New(isolate, tpl)));
             }
 
             tpl->PrototypeTemplate()->Set(propertyName, t, attributes);
@@ -2312,6 +3381,62 @@ JSVM_Status OH_JSVM_GetAllPropertyNames(JSVM_Env env,
     return ClearLastError(env);
 }
 
+JSVM_Status OH_JSVM_GetOwnKeysUtf8(JSVM_Env env, JSVM_Value object, const JSVM_KeyName** keys, size_t* count)
+{
+    JSVM_API_ENTER(env, K_JSVM_ACCESS_JS_RUNTIME);
+    CHECK_ARG(env, keys);
+    CHECK_ARG(env, count);
+    CHECK_SCOPE(env, object);
+
+    v8::Local<v8::Context> context = env->context();
+    v8::Local<v8::Object> obj;
+    CHECK_TO_OBJECT(env, context, obj, object);
+
+    v8::HandleScope scope(env->isolate);
+    auto filter = static_cast<v8::PropertyFilter>(v8::PropertyFilter::ONLY_ENUMERABLE |
+                                                  v8::PropertyFilter::SKIP_SYMBOLS);
+    auto maybeNames = obj->GetPropertyNames(context, v8::KeyCollectionMode::kOwnOnly, filter,
+                                            v8::IndexFilter::kIncludeIndices, v8::KeyConversionMode::kKeepNumbers);
+    CHECK_MAYBE_EMPTY_WITH_PREAMBLE(env, maybeNames, JSVM_GENERIC_FAILURE);
+    v8::Local<v8::Array> names = maybeNames.ToLocalChecked();
+
+    // A UTF-16 code unit takes at most three bytes, and each name a terminator.
+    constexpr size_t maxBytesPerUnit = 3;
+    uint32_t length = names->Length();
+    std::vector<v8::Local<v8::String>> strings(length);
+    size_t capacity = 0;
+    for (uint32_t i = 0; i < length; ++i) {
+        auto maybeKey = names->Get(context, i);
+        CHECK_MAYBE_EMPTY_WITH_PREAMBLE(env, maybeKey, JSVM_GENERIC_FAILURE);
+        v8::Local<v8::Value> key = maybeKey.ToLocalChecked();
+        if (!key->IsString()) {
+            auto maybeString = key->ToString(context);
+            CHECK_MAYBE_EMPTY_WITH_PREAMBLE(env, maybeString, JSVM_GENERIC_FAILURE);
+            key = maybeString.ToLocalChecked();
+        }
+        strings[i] = key.As<v8::String>();
+        capacity += static_cast<size_t>(strings[i]->Length()) * maxBytesPerUnit + 1;
+    }
+
+    // All names are encoded once into one buffer of the env, reused by the next call.
+    if (env->ownKeyNames.size() < capacity) {
+        env->ownKeyNames.resize(capacity);
+    }
+    env->ownKeys.resize(length);
+    char* buf = env->ownKeyNames.data();
+    size_t offset = 0;
+    for (uint32_t i = 0; i < length; ++i) {
+        size_t copied = v8impl::WriteUtf8(env->isolate, strings[i], buf + offset, capacity - 1 - offset);
+        buf[offset + copied] = '\0';
+        env->ownKeys[i] = { buf + offset, copied };
+        offset += copied + 1;
+    }
+
+    *keys = env->ownKeys.data();
+    *count = length;
+    return GET_RETURN_STATUS(env);
+}
+
 JSVM_Status OH_JSVM_SetProperty(JSVM_Env env, JSVM_Value object, JSVM_Value key, JSVM_Value value)
 {
     JSVM_API_ENTER(env, K_JSVM_ACCESS_JS_RUNTIME);
@@ -2378,6 +3503,68 @@ JSVM_Status OH_JSVM_GetProperty(JSVM_Env env, JSVM_Value object, JSVM_Value key,
     return GET_RETURN_STATUS(env);
 }
 
+JSVM_Status OH_JSVM_GetProperties(JSVM_Env env,
+                                  JSVM_Value object,
+                                  size_t count,
+                                  const JSVM_Value* keys,
+                                  JSVM_Value* results)
+{
+    JSVM_API_ENTER(env, K_JSVM_ACCESS_JS_RUNTIME);
+    CHECK_SCOPE(env, object);
+    if (count > 0) {
+        CHECK_ARG(env, keys);
+        CHECK_ARG(env, results);
+    }
+
+    v8::Local<v8::Context> context = env->context();
+    v8::Local<v8::Object> obj;
+
+    CHECK_TO_OBJECT(env, context, obj, object);
+
+    for (size_t i = 0; i < count; i++) {
+        CHECK_ARG(env, keys[i]);
+        CHECK_SCOPE(env, keys[i]);
+
+        auto getMaybe = obj->Get(context, v8impl::V8LocalValueFromJsValue(keys[i]));
+        CHECK_MAYBE_EMPTY_WITH_PREAMBLE(env, getMaybe, JSVM_GENERIC_FAILURE);
+
+        results[i] = v8impl::JsValueFromV8LocalValue(getMaybe.ToLocalChecked());
+        ADD_VAL_TO_SCOPE_CHECK(env, results[i]);
+    }
+    return GET_RETURN_STATUS(env);
+}
+
+JSVM_Status OH_JSVM_SetProperties(JSVM_Env env,
+                                  JSVM_Value object,
+                                  size_t count,
+                                  const JSVM_Value* keys,
+                                  const JSVM_Value* values)
+{
+    JSVM_API_ENTER(env, K_JSVM_ACCESS_JS_RUNTIME);
+    CHECK_SCOPE(env, object);
+    if (count > 0) {
+        CHECK_ARG(env, keys);
+        CHECK_ARG(env, values);
+    }
+
+    v8::Local<v8::Context> context = env->context();
+    v8::Local<v8::Object> obj;
+
+    CHECK_TO_OBJECT(env, context, obj, object);
+
+    for (size_t i = 0; i < count; i++) {
+        CHECK_ARG(env, keys[i]);
+        CHECK_ARG(env, values[i]);
+        CHECK_SCOPE(env, keys[i]);
+        CHECK_SCOPE(env, values[i]);
+
+        v8::Maybe<bool> setMaybe =
+            obj->Set(context, v8impl::V8LocalValueFromJsValue(keys[i]), v8impl::V8LocalValueFromJsValue(values[i]));
+        RETURN_STATUS_IF_FALSE_WITH_PREAMBLE(env, setMaybe.FromMaybe(false), JSVM_GENERIC_FAILURE);
+    }
+    return GET_RETURN_STATUS(env);
+}
+
 JSVM_Status OH_JSVM_DeleteProperty(JSVM_Env env, JSVM_Value object, JSVM_Value key, bool* result)
 {
     JSVM_API_ENTER(env, K_JSVM_ACCESS_JS_RUNTIME);
@@ -2442,9 +3629,114 @@ JSVM_Status OH_JSVM_SetNamedProperty(JSVM_Env env, JSVM_Value object, const char
     return GET_RETURN_STATUS(env);
 }
 
-JSVM_Status OH_JSVM_HasNamedProperty(JSVM_Env env, JSVM_Value object, const char* utf8name, bool* result)
+JSVM_Status OH_JSVM_HasNamedProperty(JSVM_Env env, JSVM_Value object, const char* utf8name, bool* result)
+{
+    JSVM_API_ENTER(env, K_JSVM_ACCESS_JS_RUNTIME);
+    CHECK_ARG(env, result);
+    CHECK_SCOPE(env, object);
+
+    v8::Local<v8::Context> context = env->context();
+    v8::Local<v8::Object> obj;
+
+    CHECK_TO_OBJECT(env, context, obj, object);
+
+    v8::Local<v8::Name> key;
+    CHECK_NEW_FROM_UTF8(env, key, utf8name);
+
+    v8::Maybe<bool> hasMaybe = obj->Has(context, key);
+    CHECK_MAYBE_NOTHING(env, hasMaybe, JSVM_GENERIC_FAILURE);
+
+    *result = hasMaybe.FromMaybe(false);
+    return GET_RETURN_STATUS(env);
+}
+
+JSVM_Status OH_JSVM_GetNamedProperty(JSVM_Env env, JSVM_Value object, const char* utf8name, JSVM_Value* result)
+{
+    JSVM_API_ENTER(env, K_JSVM_ACCESS_JS_RUNTIME);
+    CHECK_ARG(env, result);
+    CHECK_SCOPE(env, object);
+
+    v8::Local<v8::Context> context = env->context();
+
+    v8::Local<v8::Name> key;
+    CHECK_NEW_FROM_UTF8(env, key, utf8name);
+
+    v8::Local<v8::Object> obj;
+
+    CHECK_TO_OBJECT(env, context, obj, object);
+
+    auto getMaybe = obj->Get(context, key);
+    CHECK_MAYBE_EMPTY(env, getMaybe, JSVM_GENERIC_FAILURE);
+
+    v8::Local<v8::Value> val = getMaybe.ToLocalChecked();
+    *result = v8impl::JsValueFromV8LocalValue(val);
+    ADD_VAL_TO_SCOPE_CHECK(env, *result);
+    return GET_RETURN_STATUS(env);
+}
+
+struct JSVM_PropertyKey__ final {
+    JSVM_PropertyKey__(v8::Isolate* isolate, v8::Local<v8::String> name) : name(isolate, name) {}
+
+    v8impl::Persistent<v8::String> name;
+};
+
+JSVM_Status OH_JSVM_CreatePropertyKey(JSVM_Env env, const char* utf8name, size_t length, JSVM_PropertyKey* result)
+{
+    JSVM_API_ENTER(env, K_JSVM_ACCESS_V8_ISOLATE);
+    CHECK_ARG(env, result);
+
+    v8::Local<v8::String> name;
+    CHECK_NEW_FROM_UTF8_LEN(env, name, utf8name, length);
+
+    *result = new JSVM_PropertyKey__(env->isolate, name);
+    return ClearLastError(env);
+}
+
+JSVM_Status OH_JSVM_ReleasePropertyKey(JSVM_Env env, JSVM_PropertyKey key)
+{
+    JSVM_API_ENTER(env, K_JSVM_ACCESS_V8_ISOLATE);
+    CHECK_ARG(env, key);
+
+    delete key;
+    return ClearLastError(env);
+}
+
+JSVM_Status OH_JSVM_GetPropertyKeyValue(JSVM_Env env, JSVM_PropertyKey key, JSVM_Value* result)
+{
+    JSVM_API_ENTER(env, K_JSVM_ACCESS_V8_ISOLATE);
+    CHECK_ARG(env, key);
+    CHECK_ARG(env, result);
+
+    *result = v8impl::JsValueFromV8LocalValue(v8::Local<v8::String>::New(env->isolate, key->name));
+    ADD_VAL_TO_SCOPE_CHECK(env, *result);
+    return ClearLastError(env);
+}
+
+JSVM_Status OH_JSVM_SetNamedPropertyByKey(JSVM_Env env, JSVM_Value object, JSVM_PropertyKey key, JSVM_Value value)
+{
+    JSVM_API_ENTER(env, K_JSVM_ACCESS_JS_RUNTIME);
+    CHECK_ARG(env, key);
+    CHECK_ARG(env, value);
+    CHECK_SCOPE(env, object);
+    CHECK_SCOPE(env, value);
+
+    v8::Local<v8::Context> context = env->context();
+    v8::Local<v8::Object> obj;
+
+    CHECK_TO_OBJECT(env, context, obj, object);
+
+    v8::Local<v8::String> name = v8::Local<v8::String>::New(env->isolate, key->name);
+    v8::Local<v8::Value> val = v8impl::V8LocalValueFromJsValue(value);
+
+    v8::Maybe<bool> setMaybe = obj->Set(context, name, val);
+    RETURN_STATUS_IF_FALSE_WITH_PREAMBLE(env, setMaybe.FromMaybe(false), JSVM_GENERIC_FAILURE);
+    return GET_RETURN_STATUS(env);
+}
+
+JSVM_Status OH_JSVM_HasNamedPropertyByKey(JSVM_Env env, JSVM_Value object, JSVM_PropertyKey key, bool* result)
 {
     JSVM_API_ENTER(env, K_JSVM_ACCESS_JS_RUNTIME);
+    CHECK_ARG(env, key);
     CHECK_ARG(env, result);
     CHECK_SCOPE(env, object);
 
@@ -2453,36 +3745,29 @@ JSVM_Status OH_JSVM_HasNamedProperty(JSVM_Env env, JSVM_Value object, const char
 
     CHECK_TO_OBJECT(env, context, obj, object);
 
-    v8::Local<v8::Name> key;
-    CHECK_NEW_FROM_UTF8(env, key, utf8name);
-
-    v8::Maybe<bool> hasMaybe = obj->Has(context, key);
-    CHECK_MAYBE_NOTHING(env, hasMaybe, JSVM_GENERIC_FAILURE);
+    v8::Maybe<bool> hasMaybe = obj->Has(context, v8::Local<v8::String>::New(env->isolate, key->name));
+    CHECK_MAYBE_NOTHING_WITH_PREAMBLE(env, hasMaybe, JSVM_GENERIC_FAILURE);
 
     *result = hasMaybe.FromMaybe(false);
     return GET_RETURN_STATUS(env);
 }
 
-JSVM_Status OH_JSVM_GetNamedProperty(JSVM_Env env, JSVM_Value object, const char* utf8name, JSVM_Value* result)
+JSVM_Status OH_JSVM_GetNamedPropertyByKey(JSVM_Env env, JSVM_Value object, JSVM_PropertyKey key, JSVM_Value* result)
 {
     JSVM_API_ENTER(env, K_JSVM_ACCESS_JS_RUNTIME);
+    CHECK_ARG(env, key);
     CHECK_ARG(env, result);
     CHECK_SCOPE(env, object);
 
     v8::Local<v8::Context> context = env->context();
-
-    v8::Local<v8::Name> key;
-    CHECK_NEW_FROM_UTF8(env, key, utf8name);
-
     v8::Local<v8::Object> obj;
 
     CHECK_TO_OBJECT(env, context, obj, object);
 
-    auto getMaybe = obj->Get(context, key);
-    CHECK_MAYBE_EMPTY(env, getMaybe, JSVM_GENERIC_FAILURE);
+    auto getMaybe = obj->Get(context, v8::Local<v8::String>::New(env->isolate, key->name));
+    CHECK_MAYBE_EMPTY_WITH_PREAMBLE(env, getMaybe, JSVM_GENERIC_FAILURE);
 
-    v8::Local<v8::Value> val = getMaybe.ToLocalChecked();
-    *result = v8impl::JsValueFromV8LocalValue(val);
+    *result = v8impl::JsValueFromV8LocalValue(getMaybe.ToLocalChecked());
     ADD_VAL_TO_SCOPE_CHECK(env, *result);
     return GET_RETURN_STATUS(env);
 }
@@ -2583,7 +3868,18 @@ JSVM_Status OH_JSVM_DefineProperties(JSVM_Env env,
         v8::Local<v8::Name> propertyName;
         STATUS_CALL(v8impl::V8NameFromPropertyDescriptor(env, p, &propertyName));
 
-        if (p->getter != nullptr || p->setter != nullptr) {
+        if (v8impl::IsLazyDataProperty(p)) {
+            RETURN_STATUS_IF_FALSE(env, p->getter != nullptr && p->setter == nullptr, JSVM_INVALID_ARG);
+            v8::Local<v8::Value> cbdata = v8impl::CallbackBundle::New(env, p->getter);
+            RETURN_STATUS_IF_FALSE(env, !cbdata.IsEmpty(), JSVM_GENERIC_FAILURE);
+
+            auto defineMaybe =
+                obj->SetLazyDataProperty(context, propertyName, v8impl::LazyDataPropertyWrapper::GetInvoke(env),
+                                         cbdata, v8impl::V8PropertyAttributesFromDescriptor(p));
+            if (!defineMaybe.FromMaybe(false)) {
+                return SetLastError(env, JSVM_INVALID_ARG);
+            }
+        } else if (p->getter != nullptr || p->setter != nullptr) {
             v8::Local<v8::Function> localGetter;
             v8::Local<v8::Function> localSetter;
 
@@ -2604,7 +3900,17 @@ JSVM_Status OH_JSVM_DefineProperties(JSVM_Env env,
             }
         } else if (p->method != nullptr) {
             v8::Local<v8::Function> method;
-            STATUS_CALL(v8impl::FunctionCallbackWrapper::NewFunction(env, p->method, &method));
+            if ((p->attributes & JSVM_FAST_CALL) != 0) {
+                std::vector<std::unique_ptr<v8impl::FastCallInfo>> fastCalls;
+                v8::Local<v8::FunctionTemplate> tpl;
+                STATUS_CALL(v8impl::NewMethodTemplate(env, p, &fastCalls, &tpl));
+                v8::MaybeLocal<v8::Function> maybeMethod = tpl->GetFunction(context);
+                CHECK_MAYBE_EMPTY(env, maybeMethod, JSVM_GENERIC_FAILURE);
+                method = maybeMethod.ToLocalChecked();
+                v8impl::AttachFastCalls(env, method, fastCalls);
+            } else {
+                STATUS_CALL(v8impl::FunctionCallbackWrapper::NewFunction(env, p->method, &method));
+            }
             v8::PropertyDescriptor descriptor(method, (p->attributes & JSVM_WRITABLE) != 0);
             descriptor.set_enumerable((p->attributes & JSVM_ENUMERABLE) != 0);
             descriptor.set_configurable((p->attributes & JSVM_CONFIGURABLE) != 0);
@@ -2719,6 +4025,195 @@ JSVM_Status OH_JSVM_GetArrayLength(JSVM_Env env, JSVM_Value value, uint32_t* res
     return GET_RETURN_STATUS(env);
 }
 
+namespace {
+// Returns 0 for an invalid kind.
+size_t GetElementSize(JSVM_ElementKind kind)
+{
+    switch (kind) {
+        case JSVM_ELEMENT_INT32:
+            return sizeof(int32_t);
+        case JSVM_ELEMENT_UINT32:
+            return sizeof(uint32_t);
+        case JSVM_ELEMENT_DOUBLE:
+            return sizeof(double);
+        case JSVM_ELEMENT_BOOL:
+            return sizeof(bool);
+        case JSVM_ELEMENT_VALUE:
+            return sizeof(JSVM_Value);
+        default:
+            return 0;
+    }
+}
+
+// Elements of primitive kinds are decoded like typed callback arguments.
+JSVM_ArgType GetElementArgType(JSVM_ElementKind kind)
+{
+    switch (kind) {
+        case JSVM_ELEMENT_INT32:
+            return JSVM_ARG_INT32;
+        case JSVM_ELEMENT_UINT32:
+            return JSVM_ARG_UINT32;
+        case JSVM_ELEMENT_DOUBLE:
+            return JSVM_ARG_DOUBLE;
+        default:
+            return JSVM_ARG_BOOL;
+    }
+}
+
+v8::Local<v8::Value> NewElement(v8::Isolate* isolate, JSVM_ElementKind kind, const void* data, size_t index)
+{
+    switch (kind) {
+        case JSVM_ELEMENT_INT32:
+            return v8::Integer::New(isolate, static_cast<const int32_t*>(data)[index]);
+        case JSVM_ELEMENT_UINT32:
+            return v8::Integer::NewFromUnsigned(isolate, static_cast<const uint32_t*>(data)[index]);
+        case JSVM_ELEMENT_DOUBLE:
+            return v8::Number::New(isolate, static_cast<const double*>(data)[index]);
+        default:
+            return v8::Boolean::New(isolate, static_cast<const bool*>(data)[index]);
+    }
+}
+
+struct ArrayCopyState {
+    JSVM_Env env;
+    JSVM_ArgType type;
+    size_t elementSize;
+    uint8_t* buffer;
+    size_t length;
+    size_t copied;
+    bool mismatch;
+};
+
+// Must neither allocate nor call back into JavaScript, see v8::Array::Iterate.
+v8::Array::CallbackResult CopyArrayElement(uint32_t index, v8::Local<v8::Value> element, void* data)
+{
+    auto* state = static_cast<ArrayCopyState*>(data);
+    if (state->copied == state->length) {
+        return v8::Array::CallbackResult::kBreak;
+    }
+    JSVM_ArgSpec spec = { state->type, state->buffer + state->copied * state->elementSize, 0, nullptr };
+    if (!v8impl::DecodeTypedArg(state->env, element, spec)) {
+        state->mismatch = true;
+        return v8::Array::CallbackResult::kBreak;
+    }
+    ++state->copied;
+    return v8::Array::CallbackResult::kContinue;
+}
+
+struct ArrayForEachState {
+    JSVM_Env env;
+    JSVM_ArrayElementCallback callback;
+    void* data;
+};
+
+v8::Array::CallbackResult VisitArrayElement(uint32_t index, v8::Local<v8::Value> element, void* data)
+{
+    auto* state = static_cast<ArrayForEachState*>(data);
+    if (!state->callback(state->env, index, v8impl::JsValueFromV8LocalValue(element), state->data)) {
+        return v8::Array::CallbackResult::kBreak;
+    }
+    return v8::Array::CallbackResult::kContinue;
+}
+} // namespace
+
+JSVM_Status OH_JSVM_CreateArrayFromBuffer(JSVM_Env env,
+                                          JSVM_ElementKind kind,
+                                          const void* data,
+                                          size_t length,
+                                          JSVM_Value* result)
+{
+    JSVM_API_ENTER(env, K_JSVM_ACCESS_V8_CONTEXT);
+    CHECK_ARG(env, result);
+    RETURN_STATUS_IF_FALSE(env, data != nullptr || length == 0, JSVM_INVALID_ARG);
+    RETURN_STATUS_IF_FALSE(env, length <= v8impl::K_MAX_ARRAY_ELEMENTS_LENGTH, JSVM_INVALID_ARG);
+    RETURN_STATUS_IF_FALSE(env, GetElementSize(kind) != 0, JSVM_INVALID_ARG);
+
+    v8::Isolate* isolate = env->isolate;
+    v8::Local<v8::Array> array;
+    if (kind == JSVM_ELEMENT_VALUE) {
+        const JSVM_Value* values = static_cast<const JSVM_Value*>(data);
+        RETURN_STATUS_IF_FALSE(env, std::find(values, values + length, nullptr) == values + length, JSVM_INVALID_ARG);
+        array = v8::Array::New(isolate, reinterpret_cast<v8::Local<v8::Value>*>(const_cast<void*>(data)), length);
+    } else {
+        // The element handles are only needed until the array is built.
+        v8::EscapableHandleScope scope(isolate);
+        std::vector<v8::Local<v8::Value>> elements(length);
+        for (size_t i = 0; i < length; ++i) {
+            elements[i] = NewElement(isolate, kind, data, i);
+        }
+        array = scope.Escape(v8::Array::New(isolate, elements.data(), length));
+    }
+
+    *result = v8impl::JsValueFromV8LocalValue(array);
+    ADD_VAL_TO_SCOPE_CHECK(env, *result);
+    return ClearLastError(env);
+}
+
+JSVM_Status OH_JSVM_CopyArrayToBuffer(JSVM_Env env,
+                                      JSVM_Value array,
+                                      JSVM_ElementKind kind,
+                                      void* buffer,
+                                      size_t length,
+                                      size_t* copied)
+{
+    JSVM_API_ENTER(env, K_JSVM_ACCESS_JS_RUNTIME);
+    CHECK_ARG(env, array);
+    CHECK_SCOPE(env, array);
+    RETURN_STATUS_IF_FALSE(env, buffer != nullptr || length == 0, JSVM_INVALID_ARG);
+    size_t elementSize = GetElementSize(kind);
+    RETURN_STATUS_IF_FALSE(env, elementSize != 0, JSVM_INVALID_ARG);
+    if (copied != nullptr) {
+        *copied = 0;
+    }
+
+    v8::Local<v8::Value> val = v8impl::V8LocalValueFromJsValue(array);
+    RETURN_STATUS_IF_FALSE(env, val->IsArray(), JSVM_ARRAY_EXPECTED);
+    v8::Local<v8::Array> arr = val.As<v8::Array>();
+    v8::Local<v8::Context> context = env->context();
+
+    if (kind == JSVM_ELEMENT_VALUE) {
+        // Handles passed to the iteration callback do not outlive it, so values are read one by one.
+        JSVM_Value* values = static_cast<JSVM_Value*>(buffer);
+        size_t count = std::min(length, static_cast<size_t>(arr->Length()));
+        for (size_t i = 0; i < count; ++i) {
+            auto maybe = arr->Get(context, static_cast<uint32_t>(i));
+            CHECK_MAYBE_EMPTY_WITH_PREAMBLE(env, maybe, JSVM_GENERIC_FAILURE);
+            values[i] = v8impl::JsValueFromV8LocalValue(maybe.ToLocalChecked());
+            if (copied != nullptr) {
+                *copied = i + 1;
+            }
+        }
+        return GET_RETURN_STATUS(env);
+    }
+
+    ArrayCopyState state = {
+        env, GetElementArgType(kind), elementSize, static_cast<uint8_t*>(buffer), length, 0, false
+    };
+    CHECK_MAYBE_NOTHING_WITH_PREAMBLE(env, arr->Iterate(context, CopyArrayElement, &state), JSVM_GENERIC_FAILURE);
+    if (copied != nullptr) {
+        *copied = state.copied;
+    }
+    RETURN_STATUS_IF_FALSE(env, !state.mismatch,
+                           kind == JSVM_ELEMENT_BOOL ? JSVM_BOOLEAN_EXPECTED : JSVM_NUMBER_EXPECTED);
+    return GET_RETURN_STATUS(env);
+}
+
+JSVM_Status OH_JSVM_ArrayForEach(JSVM_Env env, JSVM_Value array, JSVM_ArrayElementCallback callback, void* data)
+{
+    JSVM_API_ENTER(env, K_JSVM_ACCESS_JS_RUNTIME);
+    CHECK_ARG(env, array);
+    CHECK_ARG(env, callback);
+    CHECK_SCOPE(env, array);
+
+    v8::Local<v8::Value> val = v8impl::V8LocalValueFromJsValue(array);
+    RETURN_STATUS_IF_FALSE(env, val->IsArray(), JSVM_ARRAY_EXPECTED);
+
+    ArrayForEachState state = { env, callback, data };
+    CHECK_MAYBE_NOTHING_WITH_PREAMBLE(env, val.As<v8::Array>()->Iterate(env->context(), VisitArrayElement, &state),
+                                      JSVM_GENERIC_FAILURE);
+    return GET_RETURN_STATUS(env);
+}
+
 JSVM_Status OH_JSVM_StrictEquals(JSVM_Env env, JSVM_Value lhs, JSVM_Value rhs, bool* result)
 {
     JSVM_API_ENTER(env, K_JSVM_ACCESS_JS_RUNTIME);
@@ -2781,6 +4276,338 @@ JSVM_Status OH_JSVM_CreateObject(JSVM_Env env, JSVM_Value* result)
     return ClearLastError(env);
 }
 
+struct JSVM_StructLayout__ final {
+    struct Field {
+        v8impl::Persistent<v8::String> name;
+        size_t offset;
+        JSVM_StructFieldType type;
+        size_t size;
+        JSVM_StructLayout nested;
+    };
+
+    std::vector<Field> fields;
+    // Instances share the hidden class built from the fields of the layout.
+    v8impl::Persistent<v8::ObjectTemplate> tpl;
+};
+
+namespace {
+template<typename T>
+inline T ReadField(const void* data, size_t offset)
+{
+    T value;
+    memcpy(&value, static_cast<const char*>(data) + offset, sizeof(T));
+    return value;
+}
+
+JSVM_Status StructToObject(JSVM_Env env,
+                           v8::Local<v8::Context> context,
+                           JSVM_StructLayout layout,
+                           const void* data,
+                           v8::Local<v8::Object>* result)
+{
+    v8::Isolate* isolate = env->isolate;
+    auto maybeObject = v8::Local<v8::ObjectTemplate>::New(isolate, layout->tpl)->NewInstance(context);
+    CHECK_MAYBE_EMPTY(env, maybeObject, JSVM_GENERIC_FAILURE);
+    v8::Local<v8::Object> obj = maybeObject.ToLocalChecked();
+
+    for (const auto& field : layout->fields) {
+        v8::Local<v8::Value> value;
+        switch (field.type) {
+            case JSVM_FIELD_INT32:
+                value = v8::Integer::New(isolate, ReadField<int32_t>(data, field.offset));
+                break;
+            case JSVM_FIELD_UINT32:
+                value = v8::Integer::NewFromUnsigned(isolate, ReadField<uint32_t>(data, field.offset));
+                break;
+            case JSVM_FIELD_INT64:
+                value = v8::Number::New(isolate, static_cast<double>(ReadField<int64_t>(data, field.offset)));
+                break;
+            case JSVM_FIELD_DOUBLE:
+                value = v8::Number::New(isolate, ReadField<double>(data, field.offset));
+                break;
+            case JSVM_FIELD_BOOL:
+                value = v8::Boolean::New(isolate, ReadField<bool>(data, field.offset));
+                break;
+            case JSVM_FIELD_UTF8: {
+                const char* str = field.size == 0 ? ReadField<const char*>(data, field.offset)
+                                                  : static_cast<const char*>(data) + field.offset;
+                if (str == nullptr) {
+                    value = v8::Null(isolate);
+                    break;
+                }
+                size_t length = field.size == 0 ? strlen(str) : strnlen(str, field.size);
+                RETURN_STATUS_IF_FALSE(env, length <= INT_MAX, JSVM_INVALID_ARG);
+                auto maybeString = v8impl::NewStringFromUtf8(isolate, str, length);
+                CHECK_MAYBE_EMPTY(env, maybeString, JSVM_GENERIC_FAILURE);
+                value = maybeString.ToLocalChecked();
+                break;
+            }
+            case JSVM_FIELD_STRUCT: {
+                v8::Local<v8::Object> nested;
+                STATUS_CALL(StructToObject(env, context, field.nested,
+                                           static_cast<const char*>(data) + field.offset, &nested));
+                value = nested;
+                break;
+            }
+            default:
+                return SetLastError(env, JSVM_INVALID_ARG);
+        }
+
+        auto name = v8::Local<v8::String>::New(isolate, field.name);
+        RETURN_STATUS_IF_FALSE(env, obj->CreateDataProperty(context, name, value).FromMaybe(false),
+                               JSVM_GENERIC_FAILURE);
+    }
+
+    *result = obj;
+    return JSVM_OK;
+}
+
+JSVM_Status ObjectToStruct(JSVM_Env env,
+                           v8::Local<v8::Context> context,
+                           JSVM_StructLayout layout,
+                           v8::Local<v8::Object> obj,
+                           void* data)
+{
+    for (const auto& field : layout->fields) {
+        if (field.type == JSVM_FIELD_UTF8 && field.size == 0) {
+            // There is no storage for the characters of pointer fields.
+            continue;
+        }
+
+        auto maybeValue = obj->Get(context, v8::Local<v8::String>::New(env->isolate, field.name));
+        CHECK_MAYBE_EMPTY(env, maybeValue, JSVM_GENERIC_FAILURE);
+        v8::Local<v8::Value> value = maybeValue.ToLocalChecked();
+        void* dest = static_cast<char*>(data) + field.offset;
+
+        // Numbers and booleans are decoded into an aligned temporary, as fields
+        // of packed structs may be unaligned.
+        alignas(8) char buffer[sizeof(int64_t)];
+        JSVM_ArgSpec spec = { JSVM_ARG_INT32, buffer, 0, nullptr };
+        JSVM_Status mismatchStatus = JSVM_NUMBER_EXPECTED;
+        size_t fieldSize = 0;
+        switch (field.type) {
+            case JSVM_FIELD_INT32:
+                fieldSize = sizeof(int32_t);
+                break;
+            case JSVM_FIELD_UINT32:
+                spec.type = JSVM_ARG_UINT32;
+                fieldSize = sizeof(uint32_t);
+                break;
+            case JSVM_FIELD_INT64:
+                spec.type = JSVM_ARG_INT64;
+                fieldSize = sizeof(int64_t);
+                break;
+            case JSVM_FIELD_DOUBLE:
+                spec.type = JSVM_ARG_DOUBLE;
+                fieldSize = sizeof(double);
+                break;
+            case JSVM_FIELD_BOOL:
+                spec.type = JSVM_ARG_BOOL;
+                fieldSize = sizeof(bool);
+                mismatchStatus = JSVM_BOOLEAN_EXPECTED;
+                break;
+            case JSVM_FIELD_UTF8:
+                spec.type = JSVM_ARG_STRING_UTF8;
+                spec.value = dest;
+                spec.bufsize = field.size;
+                mismatchStatus = JSVM_STRING_EXPECTED;
+                break;
+            case JSVM_FIELD_STRUCT:
+                RETURN_STATUS_IF_FALSE(env, value->IsObject(), JSVM_OBJECT_EXPECTED);
+                STATUS_CALL(ObjectToStruct(env, context, field.nested, value.As<v8::Object>(), dest));
+                continue;
+            default:
+                return SetLastError(env, JSVM_INVALID_ARG);
+        }
+
+        RETURN_STATUS_IF_FALSE(env, v8impl::DecodeTypedArg(env, value, spec), mismatchStatus);
+        if (fieldSize > 0) {
+            memcpy(dest, buffer, fieldSize);
+        }
+    }
+    return JSVM_OK;
+}
+} // namespace
+
+JSVM_Status OH_JSVM_CreateStructLayout(JSVM_Env env,
+                                       size_t fieldCount,
+                                       const JSVM_StructField* fields,
+                                       JSVM_StructLayout* result)
+{
+    JSVM_API_ENTER(env, K_JSVM_ACCESS_V8_ISOLATE);
+    CHECK_ARG(env, result);
+    if (fieldCount > 0) {
+        CHECK_ARG(env, fields);
+    }
+
+    v8::HandleScope scope(env->isolate);
+    v8::Local<v8::ObjectTemplate> tpl = v8::ObjectTemplate::New(env->isolate);
+    auto layout = std::make_unique<JSVM_StructLayout__>();
+    layout->fields.reserve(fieldCount);
+
+    for (size_t i = 0; i < fieldCount; i++) {
+        const JSVM_StructField* field = fields + i;
+        RETURN_STATUS_IF_FALSE(env, field->type >= JSVM_FIELD_INT32 && field->type <= JSVM_FIELD_STRUCT,
+                               JSVM_INVALID_ARG);
+        RETURN_STATUS_IF_FALSE(env, field->type != JSVM_FIELD_STRUCT || field->nested != nullptr, JSVM_INVALID_ARG);
+
+        v8::Local<v8::String> name;
+        CHECK_NEW_FROM_UTF8(env, name, field->name);
+
+        // Seed the template with a value of the field type, so that filling in
+        // the fields keeps the hidden class and field representation stable.
+        v8::Local<v8::Data> initialValue;
+        switch (field->type) {
+            case JSVM_FIELD_INT32:
+            case JSVM_FIELD_UINT32:
+                initialValue = v8::Integer::New(env->isolate, 0);
+                break;
+            case JSVM_FIELD_INT64:
+            case JSVM_FIELD_DOUBLE:
+                initialValue = v8::Number::New(env->isolate, 0.5);
+                break;
+            case JSVM_FIELD_BOOL:
+                initialValue = v8::False(env->isolate);
+                break;
+            default:
+                initialValue = v8::Null(env->isolate);
+                break;
+        }
+        tpl->Set(name, initialValue);
+
+        layout->fields.push_back({ v8impl::Persistent<v8::String>(env->isolate, name), field->offset, field->type,
+                                   field->size, field->nested });
+    }
+
+    layout->tpl.Reset(env->isolate, tpl);
+    *result = layout.release();
+    return ClearLastError(env);
+}
+
+JSVM_Status OH_JSVM_ReleaseStructLayout(JSVM_Env env, JSVM_StructLayout layout)
+{
+    JSVM_API_ENTER(env, K_JSVM_ACCESS_V8_ISOLATE);
+    CHECK_ARG(env, layout);
+
+    delete layout;
+    return ClearLastError(env);
+}
+
+JSVM_Status OH_JSVM_StructToObject(JSVM_Env env, JSVM_StructLayout layout, const void* data, JSVM_Value* result)
+{
+    JSVM_API_ENTER(env, K_JSVM_ACCESS_JS_RUNTIME);
+    CHECK_ARG(env, layout);
+    CHECK_ARG(env, data);
+    CHECK_ARG(env, result);
+
+    v8::EscapableHandleScope scope(env->isolate);
+    v8::Local<v8::Object> obj;
+    STATUS_CALL(StructToObject(env, env->context(), layout, data, &obj));
+
+    *result = v8impl::JsValueFromV8LocalValue(scope.Escape(obj));
+    ADD_VAL_TO_SCOPE_CHECK(env, *result);
+    return GET_RETURN_STATUS(env);
+}
+
+JSVM_Status OH_JSVM_ObjectToStruct(JSVM_Env env, JSVM_StructLayout layout, JSVM_Value object, void* data)
+{
+    JSVM_API_ENTER(env, K_JSVM_ACCESS_JS_RUNTIME);
+    CHECK_ARG(env, layout);
+    CHECK_ARG(env, data);
+    CHECK_SCOPE(env, object);
+
+    v8::Local<v8::Context> context = env->context();
+    v8::Local<v8::Object> obj;
+    CHECK_TO_OBJECT(env, context, obj, object);
+
+    v8::HandleScope scope(env->isolate);
+    JSVM_Status status = ObjectToStruct(env, context, layout, obj, data);
+    RETURN_STATUS_IF_FALSE_WITH_PREAMBLE(env, status == JSVM_OK, status);
+    return GET_RETURN_STATUS(env);
+}
+
+struct JSVM_ObjectShape__ final {
+    std::vector<v8impl::Persistent<v8::Name>> keys;
+    // Instances share the hidden class built from the keys of the shape.
+    v8impl::Persistent<v8::ObjectTemplate> tpl;
+};
+
+JSVM_Status OH_JSVM_DefineObjectShape(JSVM_Env env, size_t count, const JSVM_Value* keys, JSVM_ObjectShape* result)
+{
+    JSVM_API_ENTER(env, K_JSVM_ACCESS_V8_ISOLATE);
+    CHECK_ARG(env, result);
+    if (count > 0) {
+        CHECK_ARG(env, keys);
+    }
+
+    v8::Isolate* isolate = env->isolate;
+    v8::HandleScope scope(isolate);
+    v8::Local<v8::ObjectTemplate> tpl = v8::ObjectTemplate::New(isolate);
+    auto shape = std::make_unique<JSVM_ObjectShape__>();
+    shape->keys.reserve(count);
+
+    for (size_t i = 0; i < count; i++) {
+        CHECK_ARG(env, keys[i]);
+        v8::Local<v8::Value> key = v8impl::V8LocalValueFromJsValue(keys[i]);
+        RETURN_STATUS_IF_FALSE(env, key->IsName(), JSVM_NAME_EXPECTED);
+        for (size_t j = 0; j < i; j++) {
+            RETURN_STATUS_IF_FALSE(env, !key->StrictEquals(v8impl::V8LocalValueFromJsValue(keys[j])),
+                                   JSVM_INVALID_ARG);
+        }
+
+        tpl->Set(key.As<v8::Name>(), v8::Undefined(isolate));
+        shape->keys.emplace_back(isolate, key.As<v8::Name>());
+    }
+
+    shape->tpl.Reset(isolate, tpl);
+    *result = shape.release();
+    return ClearLastError(env);
+}
+
+JSVM_Status OH_JSVM_ReleaseObjectShape(JSVM_Env env, JSVM_ObjectShape shape)
+{
+    JSVM_API_ENTER(env, K_JSVM_ACCESS_V8_ISOLATE);
+    CHECK_ARG(env, shape);
+
+    delete shape;
+    return ClearLastError(env);
+}
+
+JSVM_Status OH_JSVM_CreateObjectWithShape(JSVM_Env env,
+                                          JSVM_ObjectShape shape,
+                                          const JSVM_Value* values,
+                                          JSVM_Value* result)
+{
+    JSVM_API_ENTER(env, K_JSVM_ACCESS_V8_CONTEXT);
+    CHECK_ARG(env, shape);
+    CHECK_ARG(env, result);
+    if (!shape->keys.empty()) {
+        CHECK_ARG(env, values);
+    }
+
+    v8::Isolate* isolate = env->isolate;
+    v8::Local<v8::Context> context = env->context();
+    auto maybeObject = v8::Local<v8::ObjectTemplate>::New(isolate, shape->tpl)->NewInstance(context);
+    CHECK_MAYBE_EMPTY(env, maybeObject, JSVM_GENERIC_FAILURE);
+    v8::Local<v8::Object> obj = maybeObject.ToLocalChecked();
+
+    {
+        v8::HandleScope scope(isolate);
+        for (size_t i = 0; i < shape->keys.size(); i++) {
+            CHECK_ARG(env, values[i]);
+            CHECK_SCOPE(env, values[i]);
+            auto key = v8::Local<v8::Name>::New(isolate, shape->keys[i]);
+            v8::Local<v8::Value> value = v8impl::V8LocalValueFromJsValue(values[i]);
+            RETURN_STATUS_IF_FALSE(env, obj->CreateDataProperty(context, key, value).FromMaybe(false),
+                                   JSVM_GENERIC_FAILURE);
+        }
+    }
+
+    *result = v8impl::JsValueFromV8LocalValue(obj);
+    ADD_VAL_TO_SCOPE_CHECK(env, *result);
+    return ClearLastError(env);
+}
+
 JSVM_Status OH_JSVM_CreateArray(JSVM_Env env, JSVM_Value* result)
 {
     JSVM_API_ENTER(env, K_JSVM_ACCESS_V8_CONTEXT);
@@ -2818,10 +4645,36 @@ JSVM_Status OH_JSVM_CreateStringUtf8(JSVM_Env env, const char* str, size_t lengt
 {
     JSVM_API_ENTER(env, K_JSVM_ACCESS_V8_ISOLATE);
     return v8impl::NewString(env, str, length, result, [&](v8::Isolate* isolate) {
-        return v8::String::NewFromUtf8(isolate, str, v8::NewStringType::kNormal, static_cast<int>(length));
+        if (env->stringCache != nullptr) {
+            return env->stringCache->Get(isolate, str, length);
+        }
+        return v8impl::NewStringFromUtf8(isolate, str, length == JSVM_AUTO_LENGTH ? strlen(str) : length);
     });
 }
 
+JSVM_Status OH_JSVM_SetStringCacheCapacity(JSVM_Env env, size_t capacity)
+{
+    JSVM_API_ENTER(env, K_JSVM_ACCESS_V8_ISOLATE);
+
+    delete env->stringCache;
+    env->stringCache = capacity == 0 ? nullptr : new v8impl::StringCache(capacity);
+
+    return ClearLastError(env);
+}
+
+JSVM_Status OH_JSVM_GetStringCacheStats(JSVM_Env env, uint64_t* hits, uint64_t* misses)
+{
+    JSVM_API_ENTER(env, K_JSVM_ACCESS_NO_V8);
+    CHECK_ARG(env, hits);
+    CHECK_ARG(env, misses);
+
+    v8impl::StringCache* cache = env->stringCache;
+    *hits = cache != nullptr ? cache->GetHits() : 0;
+    *misses = cache != nullptr ? cache->GetMisses() : 0;
+
+    return ClearLastError(env);
+}
+
 JSVM_Status OH_JSVM_CreateStringUtf16(JSVM_Env env, const char16_t* str, size_t length, JSVM_Value* result)
 {
     JSVM_API_ENTER(env, K_JSVM_ACCESS_V8_ISOLATE);
@@ -3190,6 +5043,41 @@ JSVM_Status OH_JSVM_GetCbInfo(JSVM_Env env,             // [in] JSVM environment
     return ClearLastError(env);
 }
 
+JSVM_Status OH_JSVM_GetCbTypedArgs(JSVM_Env env,
+                                   JSVM_CallbackInfo cbinfo,
+                                   size_t argc,
+                                   const JSVM_ArgSpec* specs,
+                                   uint64_t* mismatch)
+{
+    // Omit JSVM_PREAMBLE and GET_RETURN_STATUS because V8 calls here cannot throw
+    // JS exceptions.
+    JSVM_API_ENTER(env, K_JSVM_ACCESS_V8_ISOLATE);
+    CHECK_ARG(env, cbinfo);
+    CHECK_ARG(env, mismatch);
+    constexpr size_t maxArgc = sizeof(uint64_t) * CHAR_BIT;
+    RETURN_STATUS_IF_FALSE(env, argc <= maxArgc, JSVM_INVALID_ARG);
+    if (argc > 0) {
+        CHECK_ARG(env, specs);
+    }
+    for (size_t i = 0; i < argc; i++) {
+        CHECK_ARG(env, specs[i].value);
+    }
+
+    v8impl::CallbackWrapper* info = reinterpret_cast<v8impl::CallbackWrapper*>(cbinfo);
+    JSVM_Value argv[maxArgc];
+    info->GetArgs(argv, argc);
+
+    uint64_t bits = 0;
+    for (size_t i = 0; i < argc; i++) {
+        if (!v8impl::DecodeTypedArg(env, v8impl::V8LocalValueFromJsValue(argv[i]), specs[i])) {
+            bits |= (uint64_t { 1 } << i);
+        }
+    }
+    *mismatch = bits;
+
+    return ClearLastError(env);
+}
+
 JSVM_Status OH_JSVM_GetNewTarget(JSVM_Env env, JSVM_CallbackInfo cbinfo, JSVM_Value* result)
 {
     JSVM_API_ENTER(env, K_JSVM_ACCESS_V8_ISOLATE);
@@ -3248,6 +5136,128 @@ JSVM_Status OH_JSVM_CallFunction(JSVM_Env env,
     return ClearLastError(env);
 }
 
+JSVM_Status OH_JSVM_CallFunctionBatch(JSVM_Env env,
+                                      JSVM_Value recv,
+                                      JSVM_Value func,
+                                      size_t callCount,
+                                      size_t argc,
+                                      const JSVM_Value* argv,
+                                      JSVM_Value* results,
+                                      size_t* failedIndex)
+{
+    JSVM_API_ENTER(env, K_JSVM_ACCESS_JS_RUNTIME);
+    CHECK_ARG(env, recv);
+    CHECK_SCOPE(env, recv);
+    CHECK_SCOPE(env, func);
+    if (callCount > 0 && argc > 0) {
+        CHECK_ARG(env, argv);
+        RETURN_STATUS_IF_FALSE(env, argc <= SIZE_MAX / callCount, JSVM_INVALID_ARG);
+        if (UNLIKELY(env->debugFlags)) {
+            for (size_t i = 0; i < callCount * argc; i++) {
+                CHECK_SCOPE(env, argv[i]);
+            }
+        }
+    }
+
+    v8::Local<v8::Context> context = env->context();
+
+    v8::Local<v8::Value> v8recv = v8impl::V8LocalValueFromJsValue(recv);
+
+    v8::Local<v8::Function> v8func;
+    CHECK_TO_FUNCTION(env, v8func, func);
+
+    if (failedIndex != nullptr) {
+        *failedIndex = callCount;
+    }
+    for (size_t i = 0; i < callCount; i++) {
+        const JSVM_Value* args = argc > 0 ? argv + i * argc : nullptr;
+        auto v8args = reinterpret_cast<v8::Local<v8::Value>*>(const_cast<JSVM_Value*>(args));
+        v8::MaybeLocal<v8::Value> maybe;
+        if (results != nullptr) {
+            maybe = v8func->Call(context, v8recv, argc, v8args);
+        } else {
+            // Results which are not returned are released after each call, so that
+            // the handles of the caller's scope do not grow with callCount.
+            v8::HandleScope callScope(env->isolate);
+            (void)v8func->Call(context, v8recv, argc, v8args);
+        }
+        if (UNLIKELY(tryCatch.HasCaught())) {
+            if (failedIndex != nullptr) {
+                *failedIndex = i;
+            }
+            return SetLastError(env, JSVM_PENDING_EXCEPTION);
+        }
+
+        if (results != nullptr) {
+            CHECK_MAYBE_EMPTY(env, maybe, JSVM_GENERIC_FAILURE);
+            results[i] = v8impl::JsValueFromV8LocalValue(maybe.ToLocalChecked());
+            ADD_VAL_TO_SCOPE_CHECK(env, results[i]);
+        }
+    }
+    return ClearLastError(env);
+}
+
+struct JSVM_PreparedCall__ final {
+    JSVM_PreparedCall__(v8::Isolate* isolate, v8::Local<v8::Function> func, v8::Local<v8::Value> recv, size_t argc)
+        : func(isolate, func), recv(isolate, recv), argc(argc)
+    {}
+
+    v8impl::Persistent<v8::Function> func;
+    v8impl::Persistent<v8::Value> recv;
+    const size_t argc;
+};
+
+JSVM_Status OH_JSVM_PrepareCall(JSVM_Env env, JSVM_Value func, JSVM_Value recv, size_t argc, JSVM_PreparedCall* result)
+{
+    JSVM_API_ENTER(env, K_JSVM_ACCESS_V8_ISOLATE);
+    CHECK_ARG(env, result);
+    CHECK_SCOPE(env, func);
+    CHECK_SCOPE(env, recv);
+    RETURN_STATUS_IF_FALSE(env, argc <= INT_MAX, JSVM_INVALID_ARG);
+
+    v8::Local<v8::Function> v8func;
+    CHECK_TO_FUNCTION(env, v8func, func);
+
+    v8::Local<v8::Value> v8recv =
+        recv != nullptr ? v8impl::V8LocalValueFromJsValue(recv) : v8::Undefined(env->isolate).As<v8::Value>();
+
+    *result = new JSVM_PreparedCall__(env->isolate, v8func, v8recv, argc);
+    return ClearLastError(env);
+}
+
+JSVM_Status OH_JSVM_InvokePrepared(JSVM_Env env, JSVM_PreparedCall call, const JSVM_Value* argv, JSVM_Value* result)
+{
+    JSVM_API_ENTER(env, K_JSVM_ACCESS_JS_RUNTIME);
+    CHECK_ARG(env, call);
+    if (call->argc > 0) {
+        CHECK_ARG(env, argv);
+    }
+
+    v8::Local<v8::Function> v8func = v8::Local<v8::Function>::New(env->isolate, call->func);
+    v8::Local<v8::Value> v8recv = v8::Local<v8::Value>::New(env->isolate, call->recv);
+
+    auto maybe = v8func->Call(env->context(), v8recv, call->argc,
+                              reinterpret_cast<v8::Local<v8::Value>*>(const_cast<JSVM_Value*>(argv)));
+
+    RETURN_IF_EXCEPTION_HAS_CAUGHT(env);
+
+    if (result != nullptr) {
+        CHECK_MAYBE_EMPTY(env, maybe, JSVM_GENERIC_FAILURE);
+        *result = v8impl::JsValueFromV8LocalValue(maybe.ToLocalChecked());
+        ADD_VAL_TO_SCOPE_CHECK(env, *result);
+    }
+    return ClearLastError(env);
+}
+
+JSVM_Status OH_JSVM_ReleasePrepared(JSVM_Env env, JSVM_PreparedCall call)
+{
+    JSVM_API_ENTER(env, K_JSVM_ACCESS_V8_ISOLATE);
+    CHECK_ARG(env, call);
+
+    delete call;
+    return ClearLastError(env);
+}
+
 JSVM_Status OH_JSVM_GetGlobal(JSVM_Env env, JSVM_Value* result)
 {
     JSVM_API_ENTER(env, K_JSVM_ACCESS_V8_CONTEXT);
@@ -3602,13 +5612,16 @@ JSVM_Status OH_JSVM_GetValueStringUtf8(JSVM_Env env, JSVM_Value value, char* buf
     v8::Local<v8::Value> val = v8impl::V8LocalValueFromJsValue(value);
     RETURN_STATUS_IF_FALSE(env, val->IsString(), JSVM_STRING_EXPECTED);
 
+    size_t asciiLength = 0;
     if (!buf) {
         CHECK_ARG(env, result);
-#if JSVM_V8_NEW_VERSION
-        *result = val.As<v8::String>()->Utf8LengthV2(env->isolate);
-#else
-        *result = val.As<v8::String>()->Utf8Length(env->isolate);
-#endif
+        *result = v8impl::Utf8Length(env->isolate, val.As<v8::String>());
+    } else if (bufsize != 0 && v8impl::CopyAsciiString(env->isolate, val.As<v8::String>(), buf, bufsize - 1,
+                                                       &asciiLength)) {
+        buf[asciiLength] = '\0';
+        if (result != nullptr) {
+            *result = asciiLength;
+        }
     } else if (bufsize != 0) {
 #if JSVM_V8_NEW_VERSION
         int copied = val.As<v8::String>()->WriteUtf8V2(env->isolate, buf, bufsize - 1,
@@ -3630,6 +5643,81 @@ JSVM_Status OH_JSVM_GetValueStringUtf8(JSVM_Env env, JSVM_Value value, char* buf
     return ClearLastError(env);
 }
 
+JSVM_Status OH_JSVM_GetValueStringUtf8Alloc(JSVM_Env env,
+                                            JSVM_Value value,
+                                            JSVM_AllocateCallback allocate,
+                                            void* data,
+                                            char** result,
+                                            size_t* length)
+{
+    JSVM_API_ENTER(env, K_JSVM_ACCESS_V8_ISOLATE);
+    CHECK_ARG(env, value);
+    CHECK_ARG(env, result);
+    CHECK_SCOPE(env, value);
+
+    v8::Local<v8::Value> val = v8impl::V8LocalValueFromJsValue(value);
+    RETURN_STATUS_IF_FALSE(env, val->IsString(), JSVM_STRING_EXPECTED);
+    v8::Local<v8::String> str = val.As<v8::String>();
+
+    // Strings are encoded once into the scratch buffer, only the copy to the allocated memory is sized exactly.
+    size_t copied = v8impl::WriteUtf8ToScratch(env, str, 0);
+    env->scratchBuffer[copied] = '\0';
+    char* buf = v8impl::TakeScratchBuffer(env, allocate, data, copied + 1);
+    RETURN_STATUS_IF_FALSE(env, buf != nullptr, JSVM_GENERIC_FAILURE);
+
+    *result = buf;
+    if (length != nullptr) {
+        *length = copied;
+    }
+    return ClearLastError(env);
+}
+
+JSVM_Status OH_JSVM_GetStringArrayUtf8(JSVM_Env env,
+                                       JSVM_Value array,
+                                       JSVM_AllocateCallback allocate,
+                                       void* data,
+                                       char** buffer,
+                                       size_t* offsets,
+                                       size_t offsetsLength)
+{
+    JSVM_API_ENTER(env, K_JSVM_ACCESS_JS_RUNTIME);
+    CHECK_ARG(env, array);
+    CHECK_ARG(env, buffer);
+    CHECK_ARG(env, offsets);
+    CHECK_SCOPE(env, array);
+
+    v8::Local<v8::Value> val = v8impl::V8LocalValueFromJsValue(array);
+    RETURN_STATUS_IF_FALSE(env, val->IsArray(), JSVM_ARRAY_EXPECTED);
+    v8::Local<v8::Array> arr = val.As<v8::Array>();
+    uint32_t count = arr->Length();
+    RETURN_STATUS_IF_FALSE(env, offsetsLength > count, JSVM_INVALID_ARG);
+
+    v8::HandleScope scope(env->isolate);
+    v8::Local<v8::Context> context = env->context();
+    // Getters may run JavaScript, which may use the scratch buffer, so all elements are read before encoding.
+    std::vector<v8::Local<v8::String>> strings(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        auto getMaybe = arr->Get(context, i);
+        CHECK_MAYBE_EMPTY_WITH_PREAMBLE(env, getMaybe, JSVM_GENERIC_FAILURE);
+        v8::Local<v8::Value> element = getMaybe.ToLocalChecked();
+        RETURN_STATUS_IF_FALSE(env, element->IsString(), JSVM_STRING_EXPECTED);
+        strings[i] = element.As<v8::String>();
+    }
+
+    size_t offset = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        offsets[i] = offset;
+        offset += v8impl::WriteUtf8ToScratch(env, strings[i], offset);
+    }
+    offsets[count] = offset;
+    v8impl::ReserveScratchBuffer(env, offset, offset + 1)[offset] = '\0';
+    char* buf = v8impl::TakeScratchBuffer(env, allocate, data, offset + 1);
+    RETURN_STATUS_IF_FALSE(env, buf != nullptr, JSVM_GENERIC_FAILURE);
+
+    *buffer = buf;
+    return GET_RETURN_STATUS(env);
+}
+
 // Copies a JavaScript string into a UTF-16 string buffer. The result is the
 // number of 2-byte code units (excluding the null terminator) copied into buf.
 // A sufficient buffer size should be greater than the length of string,
@@ -3677,6 +5765,56 @@ JSVM_Status OH_JSVM_GetValueStringUtf16(JSVM_Env env, JSVM_Value value, char16_t
     return ClearLastError(env);
 }
 
+struct JSVM_StringView__ final {
+    JSVM_StringView__(v8::Isolate* isolate, v8::Local<v8::String> str) : view(isolate, str) {}
+
+    // Flattens the string. Only debug builds of V8 forbid garbage collection while the view is alive,
+    // release builds rely on the caller not allocating or running JavaScript, see OH_JSVM_GetStringView.
+    v8::String::ValueView view;
+};
+
+JSVM_Status OH_JSVM_GetStringView(JSVM_Env env,
+                                  JSVM_Value value,
+                                  JSVM_StringView* result,
+                                  const void** data,
+                                  size_t* length,
+                                  JSVM_StringEncoding* encoding)
+{
+    JSVM_API_ENTER(env, K_JSVM_ACCESS_V8_ISOLATE);
+    CHECK_ARG(env, value);
+    CHECK_ARG(env, result);
+    CHECK_ARG(env, data);
+    CHECK_ARG(env, length);
+    CHECK_ARG(env, encoding);
+    CHECK_SCOPE(env, value);
+
+    v8::Local<v8::Value> val = v8impl::V8LocalValueFromJsValue(value);
+    RETURN_STATUS_IF_FALSE(env, val->IsString(), JSVM_STRING_EXPECTED);
+
+    JSVM_StringView view = new JSVM_StringView__(env->isolate, val.As<v8::String>());
+    if (view->view.is_one_byte()) {
+        *data = view->view.data8();
+        *encoding = JSVM_STRING_LATIN1;
+    } else {
+        *data = view->view.data16();
+        *encoding = JSVM_STRING_UTF16;
+    }
+    *length = static_cast<size_t>(view->view.length());
+    *result = view;
+
+    return ClearLastError(env);
+}
+
+JSVM_Status OH_JSVM_ReleaseStringView(JSVM_Env env, JSVM_StringView view)
+{
+    JSVM_API_ENTER(env, K_JSVM_ACCESS_V8_ISOLATE);
+    CHECK_ARG(env, view);
+
+    delete view;
+
+    return ClearLastError(env);
+}
+
 JSVM_Status OH_JSVM_CoerceToBool(JSVM_Env env, JSVM_Value value, JSVM_Value* result)
 {
     JSVM_API_ENTER(env, K_JSVM_ACCESS_JS_RUNTIME);
@@ -3775,6 +5913,12 @@ JSVM_Status OH_JSVM_TypeTagObject(JSVM_Env env, JSVM_Value object, const JSVM_Ty
     CHECK_TO_OBJECT_WITH_PREAMBLE(env, context, obj, object);
     CHECK_ARG_WITH_PREAMBLE(env, typeTag);
 
+    if (v8impl::HasWrapperFields(obj)) {
+        RETURN_STATUS_IF_FALSE(env, v8impl::GetWrapperTypeTag(obj) == nullptr, JSVM_INVALID_ARG);
+        v8impl::SetWrapperTypeTag(env->isolate, obj, typeTag);
+        return ClearLastError(env);
+    }
+
     auto key = JSVM_PRIVATE_KEY(env->isolate, typeTag);
     auto maybeHas = obj->HasPrivate(context, key);
     CHECK_MAYBE_NOTHING_WITH_PREAMBLE(env, maybeHas, JSVM_GENERIC_FAILURE);
@@ -3800,6 +5944,13 @@ JSVM_Status OH_JSVM_CheckObjectTypeTag(JSVM_Env env, JSVM_Value object, const JS
     CHECK_ARG_WITH_PREAMBLE(env, typeTag);
     CHECK_ARG_WITH_PREAMBLE(env, result);
 
+    if (v8impl::HasWrapperFields(obj)) {
+        // The tag is compared in place, without reading it back from a BigInt.
+        auto tag = v8impl::GetWrapperTypeTag(obj);
+        *result = tag != nullptr && tag->first == typeTag->lower && tag->second == typeTag->upper;
+        return ClearLastError(env);
+    }
+
     auto maybeValue = obj->GetPrivate(context, JSVM_PRIVATE_KEY(env->isolate, typeTag));
     CHECK_MAYBE_EMPTY_WITH_PREAMBLE(env, maybeValue, JSVM_GENERIC_FAILURE);
     v8::Local<v8::Value> val = maybeValue.ToLocalChecked();
@@ -4881,8 +7032,11 @@ JSVM_Status OH_JSVM_DefineClassWithPropertyHandler(JSVM_Env env,
         // This code is similar to that in OH_JSVM_DefineProperties(); the
         // difference is it applies to a template instead of an object,
         // and preferred PropertyAttribute for lack of PropertyDescriptor
-        // support on ObjectTemplate.
-        if (p->getter != nullptr || p->setter != nullptr) {
+        // support on ObjectTemplate. Lazy data properties are set on the
+        // instances, so that each of them computes its own value.
+        if (v8impl::IsLazyDataProperty(p)) {
+            STATUS_CALL(v8impl::SetLazyDataProperty(env, tpl->InstanceTemplate(), propertyName, p));
+        } else if (p->getter != nullptr || p->setter != nullptr) {
             v8::Local<v8::FunctionTemplate> getterTpl;
             v8::Local<v8::FunctionTemplate> setterTpl;
             if (p->getter != nullptr) {
@@ -4896,10 +7050,9 @@ JSVM_Status OH_JSVM_DefineClassWithPropertyHandler(JSVM_Env env,
         } else if (p->method != nullptr) {
             v8::Local<v8::FunctionTemplate> t;
             if (p->attributes & JSVM_NO_RECEIVER_CHECK) {
-                STATUS_CALL(v8impl::FunctionCallbackWrapper::NewTemplate(env, p->method, &t));
+                STATUS_CALL(v8impl::NewMethodTemplate(env, p, nullptr, &t));
             } else {
-                STATUS_CALL(
-                    v8impl::FunctionCallbackWrapper::NewTemplate(env, p->method, &t, v8::Signature::New(isolate, tpl)));
+                STATUS_CALL(v8impl::NewMethodTemplate(env, p, nullptr, &t, v8::Signature::New(isolate, tpl)));
             }
 
             tpl->PrototypeTemplate()->Set(propertyName, t, attributes);
@@ -4953,7 +7106,8 @@ JSVM_Status OH_JSVM_DefineClassWithPropertyHandler(JSVM_Env env,
     // register call as function
     if (callAsFunctionCallback && callAsFunctionCallback->callback) {
         v8::Local<v8::Value> funcCbdata = v8impl::CallbackBundle::New(env, callAsFunctionCallback);
-        tpl->InstanceTemplate()->SetCallAsFunctionHandler(v8impl::FunctionCallbackWrapper::Invoke, funcCbdata);
+        tpl->InstanceTemplate()->SetCallAsFunctionHandler(v8impl::FunctionCallbackWrapper::GetInvoke(env),
+                                                          funcCbdata);
     }
 
     v8::Local<v8::Context> context = env->context();
@@ -5926,6 +8080,141 @@ JSVM_Status OH_JSVM_CreateExternalStringUtf16(JSVM_Env env,
                                      });
 }
 
+namespace {
+// Maps the regular file at path read-only. An empty file has no mapping.
+bool MapFile(const char* path, void** mapping, size_t* size)
+{
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    bool success = fstat(fd, &st) == 0 && S_ISREG(st.st_mode);
+    *size = success ? static_cast<size_t>(st.st_size) : 0;
+    *mapping = nullptr;
+    if (success && *size != 0) {
+        *mapping = mmap(nullptr, *size, PROT_READ, MAP_PRIVATE, fd, 0);
+        success = *mapping != MAP_FAILED;
+    }
+    close(fd);
+    return success;
+}
+
+#ifndef V8_ENABLE_SANDBOX
+// External string resource backed by a file mapping, which is unmapped when V8 disposes the string.
+template<typename Resource, typename CharType>
+class MappedStringResource final : public Resource {
+public:
+    MappedStringResource(v8::Isolate* isolate, void* mapping, size_t size)
+        : isolate_(isolate), mapping_(mapping), size_(size)
+    {
+        isolate_->AdjustAmountOfExternalAllocatedMemory(static_cast<int64_t>(size_));
+    }
+
+    ~MappedStringResource() override
+    {
+        munmap(mapping_, size_);
+        isolate_->AdjustAmountOfExternalAllocatedMemory(-static_cast<int64_t>(size_));
+    }
+
+    const CharType* data() const override
+    {
+        return static_cast<const CharType*>(mapping_);
+    }
+
+    size_t length() const override
+    {
+        return size_ / sizeof(CharType);
+    }
+
+private:
+    v8::Isolate* isolate_;
+    void* mapping_;
+    size_t size_;
+};
+
+using MappedOneByteStringResource = MappedStringResource<v8::String::ExternalOneByteStringResource, char>;
+using MappedTwoByteStringResource = MappedStringResource<v8::String::ExternalStringResource, uint16_t>;
+#endif // V8_ENABLE_SANDBOX
+
+v8::MaybeLocal<v8::String> NewMappedString(v8::Isolate* isolate,
+                                           JSVM_StringEncoding encoding,
+                                           void* mapping,
+                                           size_t size,
+                                           bool* copied)
+{
+#ifdef V8_ENABLE_SANDBOX
+    // External string data must live inside the sandbox, so the content is copied.
+    v8::MaybeLocal<v8::String> str;
+    if (encoding == JSVM_STRING_LATIN1) {
+        str = v8::String::NewFromOneByte(isolate, static_cast<const uint8_t*>(mapping), v8::NewStringType::kNormal,
+                                         static_cast<int>(size));
+    } else {
+        str = v8::String::NewFromTwoByte(isolate, static_cast<const uint16_t*>(mapping), v8::NewStringType::kNormal,
+                                         static_cast<int>(size / sizeof(uint16_t)));
+    }
+    munmap(mapping, size);
+    *copied = true;
+    return str;
+#else
+    *copied = false;
+    if (encoding == JSVM_STRING_LATIN1) {
+        auto resource = new MappedOneByteStringResource(isolate, mapping, size);
+        auto str = v8::String::NewExternalOneByte(isolate, resource);
+        if (str.IsEmpty()) {
+            delete resource;
+        }
+        return str;
+    }
+    auto resource = new MappedTwoByteStringResource(isolate, mapping, size);
+    auto str = v8::String::NewExternalTwoByte(isolate, resource);
+    if (str.IsEmpty()) {
+        delete resource;
+    }
+    return str;
+#endif // V8_ENABLE_SANDBOX
+}
+} // namespace
+
+JSVM_Status OH_JSVM_CreateExternalStringFromFile(JSVM_Env env,
+                                                 const char* path,
+                                                 JSVM_StringEncoding encoding,
+                                                 JSVM_Value* result,
+                                                 bool* copied)
+{
+    JSVM_API_ENTER(env, K_JSVM_ACCESS_V8_ISOLATE);
+    CHECK_ARG(env, path);
+    CHECK_ARG(env, result);
+    CHECK_ARG(env, copied);
+    RETURN_STATUS_IF_FALSE(env, encoding == JSVM_STRING_LATIN1 || encoding == JSVM_STRING_UTF16, JSVM_INVALID_ARG);
+
+    void* mapping = nullptr;
+    size_t size = 0;
+    RETURN_STATUS_IF_FALSE(env, MapFile(path, &mapping, &size), JSVM_GENERIC_FAILURE);
+    if (size == 0) {
+        *copied = false;
+        *result = v8impl::JsValueFromV8LocalValue(v8::String::Empty(env->isolate));
+        return ClearLastError(env);
+    }
+
+    // Only ASCII is accepted as Latin-1, so that UTF-8 sources are not silently misread.
+    size_t charSize = encoding == JSVM_STRING_LATIN1 ? sizeof(char) : sizeof(char16_t);
+    bool valid = size % charSize == 0 && size / charSize <= static_cast<size_t>(v8::String::kMaxLength);
+    if (valid && encoding == JSVM_STRING_LATIN1) {
+        valid = jsvm::IsAscii(static_cast<const uint8_t*>(mapping), size);
+    }
+    if (!valid) {
+        munmap(mapping, size);
+        return SetLastError(env, JSVM_INVALID_ARG);
+    }
+
+    auto str = NewMappedString(env->isolate, encoding, mapping, size, copied);
+    CHECK_MAYBE_EMPTY(env, str, JSVM_GENERIC_FAILURE);
+    *result = v8impl::JsValueFromV8LocalValue(str.ToLocalChecked());
+    ADD_VAL_TO_SCOPE_CHECK(env, *result);
+    return ClearLastError(env);
+}
+
 JSVM_GCType GetJSVMGCType(v8::GCType gcType)
 {
     switch (gcType) {
@@ -6305,7 +8594,8 @@ JSVM_Status ProcessPropertyHandler(JSVM_Env env,
     // register call as function
     if (callAsFunctionCallback && callAsFunctionCallback->callback) {
         v8::Local<v8::Value> funcCbdata = v8impl::CallbackBundle::New(env, callAsFunctionCallback);
-        tpl->InstanceTemplate()->SetCallAsFunctionHandler(v8impl::FunctionCallbackWrapper::Invoke, funcCbdata);
+        tpl->InstanceTemplate()->SetCallAsFunctionHandler(v8impl::FunctionCallbackWrapper::GetInvoke(env),
+                                                          funcCbdata);
     }
     return JSVM_OK;
 }
@@ -6330,6 +8620,17 @@ public:
                     instance_templ->SetInternalFieldCount(count);
                     break;
                 }
+                case JSVM_DEFINE_CLASS_WITH_WRAPPER_FIELD:
+                    // The constructor template is created with the wrapper fields, see NewWrapperFieldTemplate.
+                    hasWrapperFields = true;
+                    break;
+                case JSVM_DEFINE_CLASS_WITH_ID:
+                    // Resolved before the template is created, see OH_JSVM_DefineClassWithOptions.
+                    break;
+                case JSVM_DEFINE_CLASS_WITH_NATIVE_ELEMENTS:
+                    hasNativeElements = true;
+                    nativeElements = static_cast<const JSVM_NativeElements*>(options[i].content.ptr);
+                    break;
                 case JSVM_DEFINE_CLASS_WITH_PROPERTY_HANDLER: {
                     hasPropertyHandle = true;
                     auto* propertyHandle = static_cast<JSVM_PropertyHandler*>(options[i].content.ptr);
@@ -6344,6 +8645,16 @@ public:
                 }
             }
         }
+        // A count set by JSVM_DEFINE_CLASS_WITH_COUNT must not drop the wrapper fields.
+        v8::Local<v8::ObjectTemplate> instanceTemplate = tpl->InstanceTemplate();
+        if (hasWrapperFields && instanceTemplate->InternalFieldCount() < v8impl::K_WRAPPER_FIELD_COUNT) {
+            instanceTemplate->SetInternalFieldCount(v8impl::K_WRAPPER_FIELD_COUNT);
+        }
+        // Native elements replace the indexed handler of a property handler, whatever the option order.
+        if (status == JSVM_OK && hasNativeElements &&
+            !v8impl::SetNativeElementsHandler(env->isolate, instanceTemplate, nativeElements)) {
+            status = JSVM_INVALID_ARG;
+        }
     }
 
     JSVM_Status GetStatus()
@@ -6365,47 +8676,52 @@ private:
     JSVM_PropertyHandlerCfg propertyHandlerCfg = nullptr;
     JSVM_Callback callAsFunctionCallback = nullptr;
     bool hasPropertyHandle = false;
+    bool hasWrapperFields = false;
+    bool hasNativeElements = false;
+    const JSVM_NativeElements* nativeElements = nullptr;
     JSVM_Status status = JSVM_OK;
     v8impl::JSVM_PropertyHandlerCfgStruct* propertyHandlerCfgStruct = nullptr;
 };
 
-JSVM_Status OH_JSVM_DefineClassWithOptions(JSVM_Env env,
-                                           const char* utf8name,
-                                           size_t length,
-                                           JSVM_Callback constructor,
-                                           size_t propertyCount,
-                                           const JSVM_PropertyDescriptor* properties,
-                                           JSVM_Value parentClass,
-                                           size_t optionCount,
-                                           JSVM_DefineClassOptions options[],
-                                           JSVM_Value* result)
+// Returns the first option with the given id, or nullptr if there is none.
+static const JSVM_DefineClassOptions* FindDefineClassOption(size_t optionCount,
+                                                            const JSVM_DefineClassOptions options[],
+                                                            JSVM_DefineClassOptionsId id)
 {
-    JSVM_API_ENTER(env, K_JSVM_ACCESS_JS_RUNTIME);
-    CHECK_ARG(env, result);
-    CHECK_ARG(env, constructor);
-    CHECK_ARG(env, constructor->callback);
-    CHECK_SCOPE(env, parentClass);
-
-    if (propertyCount > 0) {
-        CHECK_ARG(env, properties);
-    }
+    auto end = options + optionCount;
+    auto option = std::find_if(options, end, [id](const JSVM_DefineClassOptions& option) { return option.id == id; });
+    return option != end ? option : nullptr;
+}
 
+// Creates the constructor template of a class with the prototype properties in properties. Shared templates
+// do not bind their callbacks to env, so that all envs of the VM can instantiate them.
+static JSVM_Status NewClassTemplate(JSVM_Env env,
+                                    const char* utf8name,
+                                    size_t length,
+                                    JSVM_Callback constructor,
+                                    size_t propertyCount,
+                                    const JSVM_PropertyDescriptor* properties,
+                                    bool wrapperFields,
+                                    bool shared,
+                                    v8::Local<v8::FunctionTemplate>* result)
+{
     v8::Isolate* isolate = env->isolate;
-    v8::EscapableHandleScope scope(isolate);
     v8::Local<v8::FunctionTemplate> tpl;
-    STATUS_CALL(v8impl::FunctionCallbackWrapper::NewTemplate(env, constructor, &tpl));
+    if (wrapperFields) {
+        STATUS_CALL(v8impl::FunctionCallbackWrapper::NewWrapperFieldTemplate(env, constructor, &tpl, shared));
+    } else {
+        STATUS_CALL(v8impl::FunctionCallbackWrapper::NewTemplate(env, constructor, &tpl, {}, shared));
+    }
 
     v8::Local<v8::String> nameString;
     CHECK_NEW_FROM_UTF8_LEN(env, nameString, utf8name, length);
     tpl->SetClassName(nameString);
 
-    size_t staticPropertyCount = 0;
     for (size_t i = 0; i < propertyCount; i++) {
         const JSVM_PropertyDescriptor* p = properties + i;
 
         if ((p->attributes & JSVM_STATIC) != 0) { // attributes
-            // Static properties are handled separately below.
-            staticPropertyCount++;
+            // Static properties are defined on the constructor of each env.
             continue;
         }
         v8::Local<v8::Name> propertyName;
@@ -6414,22 +8730,24 @@ JSVM_Status OH_JSVM_DefineClassWithOptions(JSVM_Env env,
 
         // This code is similar to that in OH_JSVM_DefineProperties(); the
         // and preferred PropertyAttribute for lack of PropertyDescriptor
-        // support on ObjectTemplate.
-        if (p->getter != nullptr || p->setter != nullptr) {
+        // support on ObjectTemplate. Lazy data properties are set on the
+        // instances, so that each of them computes its own value.
+        if (v8impl::IsLazyDataProperty(p)) {
+            STATUS_CALL(v8impl::SetLazyDataProperty(env, tpl->InstanceTemplate(), propertyName, p, shared));
+        } else if (p->getter != nullptr || p->setter != nullptr) {
             v8::Local<v8::FunctionTemplate> getterTpl;
             v8::Local<v8::FunctionTemplate> setterTpl;
             if (p->getter != nullptr) {
-                STATUS_CALL(v8impl::FunctionCallbackWrapper::NewTemplate(env, p->getter, &getterTpl));
+                STATUS_CALL(v8impl::FunctionCallbackWrapper::NewTemplate(env, p->getter, &getterTpl, {}, shared));
             }
             if (p->setter != nullptr) {
-                STATUS_CALL(v8impl::FunctionCallbackWrapper::NewTemplate(env, p->setter, &setterTpl));
+                STATUS_CALL(v8impl::FunctionCallbackWrapper::NewTemplate(env, p->setter, &setterTpl, {}, shared));
             }
 
             tpl->PrototypeTemplate()->SetAccessorProperty(propertyName, getterTpl, setterTpl, attributes);
         } else if (p->method != nullptr) {
             v8::Local<v8::FunctionTemplate> temp;
-            STATUS_CALL(
-                v8impl::FunctionCallbackWrapper::NewTemplate(env, p->method, &temp, v8::Signature::New(isolate, tpl)));
+            STATUS_CALL(v8impl::NewMethodTemplate(env, p, nullptr, &temp, v8::Signature::New(isolate, tpl), shared));
 
             tpl->PrototypeTemplate()->Set(propertyName, temp, attributes);
         } else {
@@ -6438,19 +8756,67 @@ JSVM_Status OH_JSVM_DefineClassWithOptions(JSVM_Env env,
         }
     }
 
-    if (parentClass != nullptr) {
-        v8::Local<v8::Function> parentFunc;
-        CHECK_TO_FUNCTION(env, parentFunc, parentClass);
-        if (!tpl->Inherit(parentFunc)) {
-            return JSVM_INVALID_ARG;
-        }
+    *result = tpl;
+    return JSVM_OK;
+}
+
+JSVM_Status OH_JSVM_DefineClassWithOptions(JSVM_Env env,
+                                           const char* utf8name,
+                                           size_t length,
+                                           JSVM_Callback constructor,
+                                           size_t propertyCount,
+                                           const JSVM_PropertyDescriptor* properties,
+                                           JSVM_Value parentClass,
+                                           size_t optionCount,
+                                           JSVM_DefineClassOptions options[],
+                                           JSVM_Value* result)
+{
+    JSVM_API_ENTER(env, K_JSVM_ACCESS_JS_RUNTIME);
+    CHECK_ARG(env, result);
+    CHECK_ARG(env, constructor);
+    CHECK_ARG(env, constructor->callback);
+    CHECK_SCOPE(env, parentClass);
+
+    if (propertyCount > 0) {
+        CHECK_ARG(env, properties);
     }
 
+    v8::Isolate* isolate = env->isolate;
+    v8::EscapableHandleScope scope(isolate);
+    v8::Local<v8::FunctionTemplate> tpl;
     DefineClassOptionsResolver optionResolver;
-    optionResolver.ProcessOptions(optionCount, options, env, tpl);
 
-    if (optionResolver.GetStatus() != JSVM_OK) {
-        return optionResolver.GetStatus();
+    // Templates can not refer to the parent class or property handler data of one env, so such classes are
+    // never shared.
+    auto idOption = FindDefineClassOption(optionCount, options, JSVM_DEFINE_CLASS_WITH_ID);
+    bool shared = idOption != nullptr && parentClass == nullptr &&
+                  FindDefineClassOption(optionCount, options, JSVM_DEFINE_CLASS_WITH_PROPERTY_HANDLER) == nullptr;
+    auto& classTemplates = v8impl::GetIsolateData(isolate)->classTemplates;
+    auto cached = shared ? classTemplates.find(idOption->content.num) : classTemplates.end();
+    if (cached != classTemplates.end()) {
+        tpl = cached->second.Get(isolate);
+    } else {
+        bool wrapperFields =
+            FindDefineClassOption(optionCount, options, JSVM_DEFINE_CLASS_WITH_WRAPPER_FIELD) != nullptr;
+        STATUS_CALL(NewClassTemplate(env, utf8name, length, constructor, propertyCount, properties, wrapperFields,
+                                     shared, &tpl));
+
+        if (parentClass != nullptr) {
+            v8::Local<v8::Function> parentFunc;
+            CHECK_TO_FUNCTION(env, parentFunc, parentClass);
+            if (!tpl->Inherit(parentFunc)) {
+                return JSVM_INVALID_ARG;
+            }
+        }
+
+        optionResolver.ProcessOptions(optionCount, options, env, tpl);
+
+        if (optionResolver.GetStatus() != JSVM_OK) {
+            return optionResolver.GetStatus();
+        }
+        if (shared) {
+            classTemplates[idOption->content.num].Set(isolate, tpl);
+        }
     }
 
     v8::Local<v8::Context> context = env->context();
@@ -6462,6 +8828,8 @@ JSVM_Status OH_JSVM_DefineClassWithOptions(JSVM_Env env,
                                       optionResolver.GetPropertyHandler(), nullptr);
     }
 
+    size_t staticPropertyCount = std::count_if(properties, properties + propertyCount,
+        [](const JSVM_PropertyDescriptor& p) { return (p.attributes & JSVM_STATIC) != 0; });
     if (staticPropertyCount > 0) {
         std::vector<JSVM_PropertyDescriptor> static_descriptors;
         static_descriptors.reserve(staticPropertyCount);
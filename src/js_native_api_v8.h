@@ -245,6 +245,9 @@ typedef JSVM_Value (*DeleterCallback)(JSVM_Env, JSVM_Value, JSVM_Value, JSVM_Val
 typedef JSVM_Value (*EnumeratorCallback)(JSVM_Env, JSVM_Value, JSVM_Value);
 
 struct JSVM_PropertyHandlerCfgStruct {
+    // The env the handlers are registered in, saves resolving it from the
+    // current context on every interception.
+    JSVM_Env env;
     GetterCallback namedGetterCallback;
     SetterCallback namedSetterCallback;
     DeleterCallback nameDeleterCallback;
@@ -261,6 +264,7 @@ inline JSVM_PropertyHandlerCfgStruct* CreatePropertyCfg(JSVM_Env env, JSVM_Prope
 {
     JSVM_PropertyHandlerCfgStruct* newPropertyCfg = new JSVM_PropertyHandlerCfgStruct;
     if (newPropertyCfg != nullptr && propertyCfg != nullptr) {
+        newPropertyCfg->env = env;
         newPropertyCfg->namedGetterCallback = propertyCfg->genericNamedPropertyGetterCallback;
         newPropertyCfg->namedSetterCallback = propertyCfg->genericNamedPropertySetterCallback;
         newPropertyCfg->nameDeleterCallback = propertyCfg->genericNamedPropertyDeleterCallback;
@@ -44,6 +44,8 @@ void JSVM_Env__::DeleteMe()
 {
     v8impl::RefTracker::FinalizeAll(&finalizerList);
     v8impl::RefTracker::FinalizeAll(&userReferenceList);
+    // The functions may still be called from other envs, their bundles are kept by the VM.
+    v8impl::RefTracker::FinalizeAll(&callbackBundleList);
 
     {
         v8::Context::Scope context_scope(context());
@@ -65,6 +67,9 @@ void JSVM_Env__::DeleteMe()
         scopeTracker = nullptr;
     }
 
+    delete stringCache;
+    stringCache = nullptr;
+
     delete this;
 }
 
@@ -23,6 +23,7 @@
 #include "jsvm_dfx.h"
 #include "jsvm_inspector_agent.h"
 #include "jsvm_reference.h"
+#include "jsvm_string_cache.h"
 #include "jsvm_types.h"
 #include "jsvm_util.h"
 #include "memory_manager.h"
@@ -197,6 +198,9 @@ public:
     v8impl::RefList userReferenceList;
     v8impl::RefList finalizerList;
 
+    // Callback bundles of the functions created in this env, see v8impl::CallbackBundle.
+    v8impl::RefList callbackBundleList;
+
     JSVM_ExtendedErrorInfo lastError;
 
     // Store v8::Data
@@ -219,6 +223,17 @@ public:
     bool inGcFinalizer = false;
     uint32_t debugFlags = 0;
 
+    // Opt-in cache for OH_JSVM_CreateStringUtf8, see OH_JSVM_SetStringCacheCapacity.
+    v8impl::StringCache* stringCache = nullptr;
+
+    // Reused by OH_JSVM_GetValueStringUtf8Alloc when no allocator is given.
+    std::unique_ptr<char[]> scratchBuffer;
+    size_t scratchBufferSize = 0;
+
+    // Key names returned by OH_JSVM_GetOwnKeysUtf8, reused by its next call.
+    std::vector<char> ownKeyNames;
+    std::vector<JSVM_KeyName> ownKeys;
+
 private:
     // Used for inspector
     jsvm::InspectorAgent* inspectorAgent;
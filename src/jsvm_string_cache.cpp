@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jsvm_string_cache.h"
+
+#include "jsvm.h"
+
+namespace v8impl {
+
+v8::MaybeLocal<v8::String> StringCache::Get(v8::Isolate* isolate, const char* str, size_t length)
+{
+    if (length == JSVM_AUTO_LENGTH) {
+        length = strlen(str);
+    }
+    if (length > MAX_KEY_LENGTH) {
+        return NewStringFromUtf8(isolate, str, length);
+    }
+
+    std::string_view content(str, length);
+    auto it = index_.find(content);
+    if (it != index_.end()) {
+        ++hits_;
+        entries_.splice(entries_.begin(), entries_, it->second);
+        return it->second->value.Get(isolate);
+    }
+
+    ++misses_;
+    v8::Local<v8::String> result;
+    if (!NewStringFromUtf8(isolate, str, length, v8::NewStringType::kInternalized).ToLocal(&result)) {
+        return v8::MaybeLocal<v8::String>();
+    }
+    if (entries_.size() >= capacity_) {
+        index_.erase(entries_.back().key);
+        entries_.pop_back();
+    }
+    entries_.emplace_front(isolate, content, result);
+    index_.emplace(entries_.front().key, entries_.begin());
+    return result;
+}
+
+} // namespace v8impl
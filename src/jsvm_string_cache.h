@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JSVM_STRING_CACHE_H
+#define JSVM_STRING_CACHE_H
+
+#include <cstdint>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "jsvm_util.h"
+
+namespace v8impl {
+
+// Bounded cache of internalized strings created from short UTF-8 strings,
+// evicting the least recently used entry when full. Hot strings such as enum
+// or field names then resolve to the same v8::String instead of allocating a
+// new one per call.
+class StringCache final {
+public:
+    // Longer strings bypass the cache, they are unlikely to repeat and would
+    // make the key copies expensive.
+    static constexpr size_t MAX_KEY_LENGTH = 64;
+
+    explicit StringCache(size_t capacity) : capacity_(capacity) {}
+
+    StringCache(const StringCache&) = delete;
+    StringCache& operator=(const StringCache&) = delete;
+
+    // Returns the string for the given UTF-8 content, creating and caching an
+    // internalized string on a miss. length may be JSVM_AUTO_LENGTH.
+    v8::MaybeLocal<v8::String> Get(v8::Isolate* isolate, const char* str, size_t length);
+
+    uint64_t GetHits() const
+    {
+        return hits_;
+    }
+
+    uint64_t GetMisses() const
+    {
+        return misses_;
+    }
+
+private:
+    struct Entry {
+        Entry(v8::Isolate* isolate, std::string_view content, v8::Local<v8::String> str)
+            : key(content), value(isolate, str)
+        {}
+
+        std::string key;
+        Persistent<v8::String> value;
+    };
+
+    // Most recently used entry first. The index keys view the entry keys,
+    // which stay in place since list nodes are never moved.
+    std::list<Entry> entries_;
+    std::unordered_map<std::string_view, std::list<Entry>::iterator> index_;
+    size_t capacity_;
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+};
+
+} // namespace v8impl
+
+#endif // JSVM_STRING_CACHE_H
@@ -20,6 +20,7 @@
 #include <cassert>
 #include <climits>
 #include <cstddef>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -35,6 +36,12 @@
 #include <utility>
 #include <vector>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 // jsvm header
 #include "jsvm_dfx.h"
 #include "jsvm_log.h"
@@ -70,11 +77,62 @@ constexpr size_t MaxSize()
     ((max = sizeof(Types) > max ? sizeof(Types) : max), ...);
     return max;
 }
+
+// Returns true if no byte of data has the high bit set, i.e. data is ASCII.
+inline bool IsAscii(const uint8_t* data, size_t length)
+{
+    constexpr size_t blockSize = 16;
+    size_t i = 0;
+#if defined(__SSE2__)
+    for (; i + blockSize <= length; i += blockSize) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        if (_mm_movemask_epi8(block) != 0) {
+            return false;
+        }
+    }
+#elif defined(__aarch64__)
+    constexpr uint8_t asciiMax = 0x7f;
+    for (; i + blockSize <= length; i += blockSize) {
+        if (vmaxvq_u8(vld1q_u8(data + i)) > asciiMax) {
+            return false;
+        }
+    }
+#else
+    constexpr uint64_t highBits = 0x8080808080808080ULL;
+    for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, data + i, sizeof(word));
+        if ((word & highBits) != 0) {
+            return false;
+        }
+    }
+#endif
+    constexpr uint8_t highBit = 0x80;
+    for (; i < length; ++i) {
+        if ((data[i] & highBit) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
 } // namespace jsvm
 
 namespace v8impl {
 template<typename T>
 using Persistent = v8::Global<T>;
+
+// Creates a string from length bytes of UTF-8. ASCII input is valid Latin-1, so it can skip the UTF-8 decoder.
+inline v8::MaybeLocal<v8::String> NewStringFromUtf8(v8::Isolate* isolate,
+                                                    const char* str,
+                                                    size_t length,
+                                                    v8::NewStringType type = v8::NewStringType::kNormal)
+{
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(str);
+    if (jsvm::IsAscii(bytes, length)) {
+        return v8::String::NewFromOneByte(isolate, bytes, type, static_cast<int>(length));
+    }
+    return v8::String::NewFromUtf8(isolate, str, type, static_cast<int>(length));
+}
 } // namespace v8impl
 
 enum ByteSize : uint8_t {
@@ -16,10 +16,12 @@
 #include <chrono>
 #include <csetjmp>
 #include <csignal>
+#include <cstddef>
 #include <cstring>
 #include <deque>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <thread>
 #include <vector>
@@ -2730,4 +2732,1932 @@ HWTEST_F(JSVMTest, JSVMHeapThresholdAddCallbackWithOutRemove, TestSize.Level1)
 
     EXPECT_TRUE(g_heapThresholdCallbackCalled);
     EXPECT_TRUE(g_syncSnapshotFinished);
-}
\ No newline at end of file
+}
+
+// ============================================================================
+// Fast call function tests
+// ============================================================================
+static int g_fastAddCalls = 0;
+static int g_slowAddCalls = 0;
+
+static double FastAdd(JSVM_Value receiver, int32_t a, double b)
+{
+    g_fastAddCalls++;
+    return a + b;
+}
+
+static JSVM_Value SlowAdd(JSVM_Env env, JSVM_CallbackInfo info)
+{
+    g_slowAddCalls++;
+    size_t argc = 2;
+    JSVM_Value argv[2] = { nullptr };
+    OH_JSVM_GetCbInfo(env, info, &argc, argv, nullptr, nullptr);
+    int32_t a = 0;
+    double b = 0;
+    OH_JSVM_GetValueInt32(env, argv[0], &a);
+    OH_JSVM_GetValueDouble(env, argv[1], &b);
+    JSVM_Value result = nullptr;
+    OH_JSVM_CreateDouble(env, a + b, &result);
+    return result;
+}
+
+static const JSVM_FastCallType g_fastAddArgs[] = { JSVM_FAST_INT32, JSVM_FAST_FLOAT64 };
+
+// Fast calls are only made from optimized code, which is not generated in jitless mode.
+// In that mode compiling a WebAssembly module always reports its cache as rejected.
+static bool InJitMode(JSVM_Env env)
+{
+    static const uint8_t emptyModule[] = { 0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00 };
+    bool cacheRejected = false;
+    JSVM_Value module = nullptr;
+    JSVMTEST_CALL(OH_JSVM_CompileWasmModule(env, emptyModule, sizeof(emptyModule), nullptr, 0, &cacheRejected,
+                                            &module));
+    return !cacheRejected;
+}
+
+static void ResetAddCalls()
+{
+    g_fastAddCalls = 0;
+    g_slowAddCalls = 0;
+}
+
+HWTEST_F(JSVMTest, JSVMCreateFunctionWithFastCall, TestSize.Level1)
+{
+    static JSVM_FastCallbackStruct fastAdd = {
+        { SlowAdd, nullptr }, reinterpret_cast<const void*>(FastAdd), JSVM_FAST_FLOAT64, 2, g_fastAddArgs
+    };
+    JSVM_Value func = nullptr;
+    JSVMTEST_CALL(OH_JSVM_CreateFunctionWithFastCall(env, "fastAdd", JSVM_AUTO_LENGTH, &fastAdd, &func));
+    jsvm::SetProperty(jsvm::Global(), "fastAdd", func);
+
+    ResetAddCalls();
+    auto result = jsvm::Run(R"JS(
+        function loop() {
+            let sum = 0;
+            for (let i = 0; i < 100000; i++) {
+                sum += fastAdd(1, 0.5);
+            }
+            return sum;
+        }
+        loop();
+    )JS");
+    ASSERT_EQ(jsvm::ToNumber(result), 150000);
+    ASSERT_EQ(g_fastAddCalls + g_slowAddCalls, 100000);
+    if (InJitMode(env)) {
+        ASSERT_GT(g_fastAddCalls, 0);
+    }
+    // Arguments which do not match the signature go through the regular callback.
+    ASSERT_EQ(jsvm::ToNumber(jsvm::Run("fastAdd('2', '0.5')")), 2.5);
+    ASSERT_EQ(jsvm::ToString(jsvm::Run("fastAdd.name")), "fastAdd");
+    jsvm::Run("try { new fastAdd(1, 2); throw 'fail'; } catch (e) { if (!(e instanceof TypeError)) throw e; }");
+}
+
+HWTEST_F(JSVMTest, JSVMDefineClassWithFastCallMethod, TestSize.Level1)
+{
+    static JSVM_FastCallbackStruct fastAdd = {
+        { SlowAdd, nullptr }, reinterpret_cast<const void*>(FastAdd), JSVM_FAST_FLOAT64, 2, g_fastAddArgs
+    };
+    static JSVM_CallbackStruct constructor = {
+        [](JSVM_Env env, JSVM_CallbackInfo info) {
+            JSVM_Value thisVar = nullptr;
+            OH_JSVM_GetCbInfo(env, info, nullptr, nullptr, &thisVar, nullptr);
+            return thisVar;
+        },
+        nullptr
+    };
+    auto attributes = static_cast<JSVM_PropertyAttributes>(JSVM_DEFAULT_METHOD | JSVM_FAST_CALL);
+    JSVM_PropertyDescriptor desc = { "add", nullptr, &fastAdd.callback, nullptr, nullptr, nullptr, attributes };
+    JSVM_Value cls = nullptr;
+    JSVMTEST_CALL(OH_JSVM_DefineClass(env, "Calc", JSVM_AUTO_LENGTH, &constructor, 1, &desc, &cls));
+    jsvm::SetProperty(jsvm::Global(), "Calc", cls);
+    ResetAddCalls();
+    auto result = jsvm::Run(R"JS(
+        const calc = new Calc();
+        let sum = 0;
+        for (let i = 0; i < 100000; i++) {
+            sum += calc.add(2, 0.25);
+        }
+        sum;
+    )JS");
+    ASSERT_EQ(jsvm::ToNumber(result), 225000);
+    ASSERT_EQ(g_fastAddCalls + g_slowAddCalls, 100000);
+    if (InJitMode(env)) {
+        ASSERT_GT(g_fastAddCalls, 0);
+    }
+
+    JSVM_Value obj = jsvm::Object();
+    JSVMTEST_CALL(OH_JSVM_DefineProperties(env, obj, 1, &desc));
+    jsvm::SetProperty(jsvm::Global(), "objWithFastAdd", obj);
+    ASSERT_EQ(jsvm::ToNumber(jsvm::Run("objWithFastAdd.add(3, 0.5)")), 3.5);
+}
+
+HWTEST_F(JSVMTest, JSVMFastCallMethodOutlivesClass, TestSize.Level1)
+{
+    static JSVM_FastCallbackStruct fastAdd = {
+        { SlowAdd, nullptr }, reinterpret_cast<const void*>(FastAdd), JSVM_FAST_FLOAT64, 2, g_fastAddArgs
+    };
+    static JSVM_CallbackStruct constructor = {
+        [](JSVM_Env env, JSVM_CallbackInfo info) {
+            JSVM_Value thisVar = nullptr;
+            OH_JSVM_GetCbInfo(env, info, nullptr, nullptr, &thisVar, nullptr);
+            return thisVar;
+        },
+        nullptr
+    };
+    auto attributes = static_cast<JSVM_PropertyAttributes>(JSVM_METHOD_NO_RECEIVER_CHECK | JSVM_FAST_CALL);
+    JSVM_PropertyDescriptor desc = { "add", nullptr, &fastAdd.callback, nullptr, nullptr, nullptr, attributes };
+    {
+        JSVM_HandleScope scope = nullptr;
+        JSVMTEST_CALL(OH_JSVM_OpenHandleScope(env, &scope));
+        JSVM_Value cls = nullptr;
+        JSVMTEST_CALL(OH_JSVM_DefineClass(env, "Calc", JSVM_AUTO_LENGTH, &constructor, 1, &desc, &cls));
+        jsvm::SetProperty(jsvm::Global(), "Calc", cls);
+        jsvm::Run("var detachedAdd = Calc.prototype.add; Calc = undefined;");
+        JSVMTEST_CALL(OH_JSVM_CloseHandleScope(env, scope));
+    }
+    // The class is gone, the method must still have its type information.
+    jsvm::TryTriggerGC();
+
+    ResetAddCalls();
+    auto result = jsvm::Run(R"JS(
+        function loop() {
+            let sum = 0;
+            for (let i = 0; i < 100000; i++) {
+                sum += detachedAdd(1, 0.5);
+            }
+            return sum;
+        }
+        loop();
+    )JS");
+    ASSERT_EQ(jsvm::ToNumber(result), 150000);
+    ASSERT_EQ(g_fastAddCalls + g_slowAddCalls, 100000);
+    if (InJitMode(env)) {
+        ASSERT_GT(g_fastAddCalls, 0);
+    }
+}
+
+HWTEST_F(JSVMTest, JSVMDefineClassWithOptionsFastCallMethod, TestSize.Level1)
+{
+    static JSVM_FastCallbackStruct fastAdd = {
+        { SlowAdd, nullptr }, reinterpret_cast<const void*>(FastAdd), JSVM_FAST_FLOAT64, 2, g_fastAddArgs
+    };
+    static JSVM_CallbackStruct constructor = {
+        [](JSVM_Env env, JSVM_CallbackInfo info) {
+            JSVM_Value thisVar = nullptr;
+            OH_JSVM_GetCbInfo(env, info, nullptr, nullptr, &thisVar, nullptr);
+            return thisVar;
+        },
+        nullptr
+    };
+    auto attributes = static_cast<JSVM_PropertyAttributes>(JSVM_DEFAULT_METHOD | JSVM_FAST_CALL);
+    JSVM_PropertyDescriptor desc = { "add", nullptr, &fastAdd.callback, nullptr, nullptr, nullptr, attributes };
+    // Defining the class again reuses the type information of its fast call methods.
+    JSVM_Value cls = nullptr;
+    for (int i = 0; i < 3; i++) {
+        JSVMTEST_CALL(OH_JSVM_DefineClassWithOptions(env, "Calc", JSVM_AUTO_LENGTH, &constructor, 1, &desc, nullptr,
+                                                     0, nullptr, &cls));
+    }
+    jsvm::SetProperty(jsvm::Global(), "Calc", cls);
+    ResetAddCalls();
+    auto result = jsvm::Run(R"JS(
+        const calc = new Calc();
+        let sum = 0;
+        for (let i = 0; i < 100000; i++) {
+            sum += calc.add(2, 0.25);
+        }
+        sum;
+    )JS");
+    ASSERT_EQ(jsvm::ToNumber(result), 225000);
+    ASSERT_EQ(g_fastAddCalls + g_slowAddCalls, 100000);
+    if (InJitMode(env)) {
+        ASSERT_GT(g_fastAddCalls, 0);
+    }
+}
+
+HWTEST_F(JSVMTest, JSVMCreateFunctionWithFastCallInvalidArgs, TestSize.Level1)
+{
+    JSVM_Value func = nullptr;
+    ASSERT_EQ(OH_JSVM_CreateFunctionWithFastCall(env, "f", JSVM_AUTO_LENGTH, nullptr, &func), JSVM_INVALID_ARG);
+
+    JSVM_FastCallbackStruct noFast = { { SlowAdd, nullptr }, nullptr, JSVM_FAST_FLOAT64, 2, g_fastAddArgs };
+    ASSERT_EQ(OH_JSVM_CreateFunctionWithFastCall(env, "f", JSVM_AUTO_LENGTH, &noFast, &func), JSVM_INVALID_ARG);
+
+    JSVM_FastCallbackStruct noArgTypes = {
+        { SlowAdd, nullptr }, reinterpret_cast<const void*>(FastAdd), JSVM_FAST_FLOAT64, 2, nullptr
+    };
+    ASSERT_EQ(OH_JSVM_CreateFunctionWithFastCall(env, "f", JSVM_AUTO_LENGTH, &noArgTypes, &func), JSVM_INVALID_ARG);
+
+    static const JSVM_FastCallType voidArg[] = { JSVM_FAST_VOID };
+    JSVM_FastCallbackStruct badArgType = {
+        { SlowAdd, nullptr }, reinterpret_cast<const void*>(FastAdd), JSVM_FAST_FLOAT64, 1, voidArg
+    };
+    ASSERT_EQ(OH_JSVM_CreateFunctionWithFastCall(env, "f", JSVM_AUTO_LENGTH, &badArgType, &func), JSVM_INVALID_ARG);
+}
+
+// OH_JSVM_GetCbTypedArgs tests
+struct TypedArgsResult {
+    int32_t i32 = 0;
+    uint32_t u32 = 0;
+    int64_t i64 = 0;
+    double d = 0;
+    bool b = false;
+    char str[8] = { 0 };
+    size_t strLength = 0;
+    void* external = nullptr;
+    void* arrayData = nullptr;
+    size_t arrayLength = 0;
+    uint64_t mismatch = 0;
+};
+
+static TypedArgsResult g_typedArgs;
+
+static JSVM_Value DecodeTypedArgs(JSVM_Env env, JSVM_CallbackInfo info)
+{
+    g_typedArgs = TypedArgsResult();
+    JSVM_ArgSpec specs[] = {
+        { JSVM_ARG_INT32, &g_typedArgs.i32, 0, nullptr },
+        { JSVM_ARG_UINT32, &g_typedArgs.u32, 0, nullptr },
+        { JSVM_ARG_INT64, &g_typedArgs.i64, 0, nullptr },
+        { JSVM_ARG_DOUBLE, &g_typedArgs.d, 0, nullptr },
+        { JSVM_ARG_BOOL, &g_typedArgs.b, 0, nullptr },
+        { JSVM_ARG_STRING_UTF8, g_typedArgs.str, sizeof(g_typedArgs.str), &g_typedArgs.strLength },
+        { JSVM_ARG_EXTERNAL, &g_typedArgs.external, 0, nullptr },
+        { JSVM_ARG_TYPEDARRAY, &g_typedArgs.arrayData, 0, &g_typedArgs.arrayLength },
+    };
+    OH_JSVM_GetCbTypedArgs(env, info, sizeof(specs) / sizeof(specs[0]), specs, &g_typedArgs.mismatch);
+    return nullptr;
+}
+
+HWTEST_F(JSVMTest, JSVMGetCbTypedArgs, TestSize.Level1)
+{
+    static JSVM_CallbackStruct cb = { DecodeTypedArgs, nullptr };
+    JSVM_Value func = nullptr;
+    JSVMTEST_CALL(OH_JSVM_CreateFunction(env, "decode", JSVM_AUTO_LENGTH, &cb, &func));
+    jsvm::SetProperty(jsvm::Global(), "decode", func);
+
+    static int nativeData = 0;
+    JSVM_Value external = nullptr;
+    JSVMTEST_CALL(OH_JSVM_CreateExternal(env, &nativeData, nullptr, nullptr, &external));
+    jsvm::SetProperty(jsvm::Global(), "ext", external);
+
+    jsvm::Run("decode(-1, 7, 2 ** 40, 0.5, true, 'hello world', ext, new Uint16Array(3))");
+    ASSERT_EQ(g_typedArgs.mismatch, 0u);
+    ASSERT_EQ(g_typedArgs.i32, -1);
+    ASSERT_EQ(g_typedArgs.u32, 7u);
+    ASSERT_EQ(g_typedArgs.i64, int64_t { 1 } << 40);
+    ASSERT_EQ(g_typedArgs.d, 0.5);
+    ASSERT_TRUE(g_typedArgs.b);
+    ASSERT_STREQ(g_typedArgs.str, "hello w");
+    ASSERT_EQ(g_typedArgs.strLength, 7u);
+    ASSERT_EQ(g_typedArgs.external, &nativeData);
+    ASSERT_NE(g_typedArgs.arrayData, nullptr);
+    ASSERT_EQ(g_typedArgs.arrayLength, 3u);
+}
+
+HWTEST_F(JSVMTest, JSVMGetCbTypedArgsMismatch, TestSize.Level1)
+{
+    static JSVM_CallbackStruct cb = { DecodeTypedArgs, nullptr };
+    JSVM_Value func = nullptr;
+    JSVMTEST_CALL(OH_JSVM_CreateFunction(env, "decode", JSVM_AUTO_LENGTH, &cb, &func));
+    jsvm::SetProperty(jsvm::Global(), "decode", func);
+
+    // Wrong types for the int32, bool and string arguments; the last three are missing.
+    jsvm::Run("decode('1', 2, 3, 4, 0, {})");
+    ASSERT_EQ(g_typedArgs.mismatch, 0b11110001u);
+    ASSERT_EQ(g_typedArgs.i32, 0);
+    ASSERT_EQ(g_typedArgs.u32, 2u);
+    ASSERT_EQ(g_typedArgs.i64, 3);
+    ASSERT_EQ(g_typedArgs.d, 4);
+}
+
+HWTEST_F(JSVMTest, JSVMGetCbTypedArgsInvalidArgs, TestSize.Level1)
+{
+    static JSVM_CallbackStruct cb = {
+        [](JSVM_Env env, JSVM_CallbackInfo info) -> JSVM_Value {
+            int32_t value = 0;
+            uint64_t mismatch = 0;
+            JSVM_ArgSpec spec = { JSVM_ARG_INT32, &value, 0, nullptr };
+            JSVM_ArgSpec nullSpec = { JSVM_ARG_INT32, nullptr, 0, nullptr };
+            bool ok = OH_JSVM_GetCbTypedArgs(env, info, 1, &spec, nullptr) == JSVM_INVALID_ARG &&
+                      OH_JSVM_GetCbTypedArgs(env, info, 1, nullptr, &mismatch) == JSVM_INVALID_ARG &&
+                      OH_JSVM_GetCbTypedArgs(env, info, 65, &spec, &mismatch) == JSVM_INVALID_ARG &&
+                      OH_JSVM_GetCbTypedArgs(env, info, 1, &nullSpec, &mismatch) == JSVM_INVALID_ARG &&
+                      OH_JSVM_GetCbTypedArgs(env, nullptr, 1, &spec, &mismatch) == JSVM_INVALID_ARG &&
+                      OH_JSVM_GetCbTypedArgs(env, info, 0, nullptr, &mismatch) == JSVM_OK;
+            JSVM_Value result = nullptr;
+            OH_JSVM_GetBoolean(env, ok, &result);
+            return result;
+        },
+        nullptr
+    };
+    JSVM_Value func = nullptr;
+    JSVMTEST_CALL(OH_JSVM_CreateFunction(env, "check", JSVM_AUTO_LENGTH, &cb, &func));
+    jsvm::SetProperty(jsvm::Global(), "check", func);
+    ASSERT_TRUE(jsvm::IsTrue(jsvm::Run("check(1)")));
+}
+
+// ============================================================================
+// Callback env tests
+// ============================================================================
+static JSVM_Env g_callbackEnv = nullptr;
+
+static JSVM_Value RecordCallbackEnv(JSVM_Env env, JSVM_CallbackInfo info)
+{
+    g_callbackEnv = env;
+    return nullptr;
+}
+
+HWTEST_F(JSVMTest, JSVMCallbackReceivesCreatingEnv, TestSize.Level1)
+{
+    static JSVM_CallbackStruct cb = { RecordCallbackEnv, nullptr };
+    JSVM_Value func = nullptr;
+    JSVMTEST_CALL(OH_JSVM_CreateFunction(env, "record", JSVM_AUTO_LENGTH, &cb, &func));
+    jsvm::SetProperty(jsvm::Global(), "record", func);
+
+    g_callbackEnv = nullptr;
+    jsvm::Run("record()");
+    ASSERT_EQ(g_callbackEnv, env);
+
+    g_callbackEnv = nullptr;
+    JSVM_Value cls = nullptr;
+    JSVMTEST_CALL(OH_JSVM_DefineClass(env, "Record", JSVM_AUTO_LENGTH, &cb, 0, nullptr, &cls));
+    jsvm::SetProperty(jsvm::Global(), "Record", cls);
+    jsvm::Run("new Record()");
+    ASSERT_EQ(g_callbackEnv, env);
+}
+
+static int g_tinyGetterCalls = 0;
+
+static JSVM_Value TinyGetter(JSVM_Env env, JSVM_CallbackInfo info)
+{
+    g_tinyGetterCalls++;
+    g_callbackEnv = env;
+    JSVM_Value result = nullptr;
+    OH_JSVM_GetBoolean(env, true, &result);
+    return result;
+}
+
+// A hot accessor keeps receiving the env it was created in, when its calls get optimized.
+HWTEST_F(JSVMTest, JSVMTinyGetterHotLoop, TestSize.Level1)
+{
+    static JSVM_CallbackStruct getter = { TinyGetter, nullptr };
+    JSVM_PropertyDescriptor desc = { "tiny", nullptr, nullptr, &getter, nullptr, nullptr, JSVM_DEFAULT };
+    JSVM_Value obj = jsvm::Object();
+    JSVMTEST_CALL(OH_JSVM_DefineProperties(env, obj, 1, &desc));
+    jsvm::SetProperty(jsvm::Global(), "tinyObj", obj);
+
+    constexpr int callCount = 100000;
+    g_tinyGetterCalls = 0;
+    g_callbackEnv = nullptr;
+    JSVM_Value result = jsvm::Run(R"JS(
+        (function () {
+            let count = 0;
+            for (let i = 0; i < 100000; i++) {
+                if (tinyObj.tiny) {
+                    count++;
+                }
+            }
+            return count;
+        })();
+    )JS");
+    ASSERT_EQ(jsvm::ToNumber(result), callCount);
+    ASSERT_EQ(g_tinyGetterCalls, callCount);
+    ASSERT_EQ(g_callbackEnv, env);
+}
+
+static JSVM_Value TinyConstructor(JSVM_Env env, JSVM_CallbackInfo info)
+{
+    JSVM_Value thisVar = nullptr;
+    OH_JSVM_GetCbInfo(env, info, nullptr, nullptr, &thisVar, nullptr);
+    return thisVar;
+}
+
+// Microbenchmark of a method bound to its env against the same method of a class shared by id, which looks the
+// env up from the current context on each call. Only reports timing.
+HWTEST_F(JSVMTest, JSVMBundledCallbackCallCost, TestSize.Level1)
+{
+    static JSVM_CallbackStruct constructor = { TinyConstructor, nullptr };
+    static JSVM_CallbackStruct method = { TinyGetter, nullptr };
+    JSVM_PropertyDescriptor desc = { "tiny", nullptr, &method, nullptr, nullptr, nullptr, JSVM_DEFAULT };
+    JSVM_Value bundledClass = nullptr;
+    JSVMTEST_CALL(OH_JSVM_DefineClass(env, "Bundled", JSVM_AUTO_LENGTH, &constructor, 1, &desc, &bundledClass));
+    JSVM_DefineClassOptions options[1];
+    options[0].id = JSVM_DEFINE_CLASS_WITH_ID;
+    options[0].content.num = 30;
+    JSVM_Value sharedClass = nullptr;
+    JSVMTEST_CALL(OH_JSVM_DefineClassWithOptions(env, "Shared", JSVM_AUTO_LENGTH, &constructor, 1, &desc, nullptr, 1,
+                                                 options, &sharedClass));
+
+    constexpr int callCount = 1000000;
+    auto measure = [&](JSVM_Value cls) {
+        JSVM_Value instance = nullptr;
+        JSVMTEST_CALL(OH_JSVM_NewInstance(env, cls, 0, nullptr, &instance));
+        // Each class gets its own loop, so that both call sites stay monomorphic.
+        JSVM_Value loop = jsvm::Run(R"JS(
+            (function (obj) {
+                let count = 0;
+                for (let i = 0; i < 1000000; i++) {
+                    if (obj.tiny()) {
+                        count++;
+                    }
+                }
+                return count;
+            })
+        )JS");
+        g_tinyGetterCalls = 0;
+        JSVM_Value result = nullptr;
+        auto start = std::chrono::steady_clock::now();
+        JSVMTEST_CALL(OH_JSVM_CallFunction(env, jsvm::Undefined(), loop, 1, &instance, &result));
+        auto end = std::chrono::steady_clock::now();
+        EXPECT_EQ(jsvm::ToNumber(result), callCount);
+        EXPECT_EQ(g_tinyGetterCalls, callCount);
+        EXPECT_EQ(g_callbackEnv, env);
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) /
+               callCount;
+    };
+
+    double bundledCost = measure(bundledClass);
+    double sharedCost = measure(sharedClass);
+    GTEST_LOG_(INFO) << "JSVMBundledCallbackCallCost: bundled " << bundledCost << " ns/call, shared " << sharedCost
+                     << " ns/call";
+}
+
+// A function stays callable from another env of the VM after the env that created it is destroyed.
+HWTEST_F(JSVMTest, JSVMCallbackOutlivesCreatingEnv, TestSize.Level1)
+{
+    static JSVM_CallbackStruct cb = { RecordCallbackEnv, nullptr };
+    JSVM_Env env2 = nullptr;
+    JSVM_EnvScope envScope2 = nullptr;
+    JSVM_HandleScope handleScope2 = nullptr;
+    JSVMTEST_CALL(OH_JSVM_CreateEnv(vm, 0, nullptr, &env2));
+    JSVMTEST_CALL(OH_JSVM_OpenEnvScope(env2, &envScope2));
+    JSVMTEST_CALL(OH_JSVM_OpenHandleScope(env2, &handleScope2));
+
+    JSVM_Value func = nullptr;
+    JSVMTEST_CALL(OH_JSVM_CreateFunction(env2, "record", JSVM_AUTO_LENGTH, &cb, &func));
+    jsvm::SetProperty(jsvm::Global(), "recordOther", func);
+    g_callbackEnv = nullptr;
+    jsvm::Run("recordOther()");
+    ASSERT_EQ(g_callbackEnv, env2);
+
+    JSVMTEST_CALL(OH_JSVM_CloseHandleScope(env2, handleScope2));
+    JSVMTEST_CALL(OH_JSVM_CloseEnvScope(env2, envScope2));
+    JSVMTEST_CALL(OH_JSVM_DestroyEnv(env2));
+
+    // The callback now gets the env of the calling script.
+    g_callbackEnv = nullptr;
+    jsvm::Run("recordOther()");
+    ASSERT_EQ(g_callbackEnv, env);
+    jsvm::TryTriggerGC();
+    g_callbackEnv = nullptr;
+    jsvm::Run("recordOther(); delete globalThis.recordOther;");
+    ASSERT_EQ(g_callbackEnv, env);
+    jsvm::TryTriggerGC();
+}
+
+// OH_JSVM_CallFunctionBatch tests
+HWTEST_F(JSVMTest, JSVMCallFunctionBatch, TestSize.Level1)
+{
+    JSVM_Value func = jsvm::Run("(function (a, b) { return a * b + this.offset; })");
+    JSVM_Value recv = jsvm::Run("({ offset: 1 })");
+    constexpr size_t callCount = 4;
+    constexpr size_t argc = 2;
+    JSVM_Value argv[callCount * argc];
+    for (size_t i = 0; i < callCount; i++) {
+        argv[i * argc] = jsvm::Int32(i);
+        argv[i * argc + 1] = jsvm::Int32(i + 1);
+    }
+    JSVM_Value results[callCount] = { nullptr };
+    size_t failedIndex = 0;
+    JSVMTEST_CALL(OH_JSVM_CallFunctionBatch(env, recv, func, callCount, argc, argv, results, &failedIndex));
+    ASSERT_EQ(failedIndex, callCount);
+    for (size_t i = 0; i < callCount; i++) {
+        ASSERT_EQ(jsvm::ToNumber(results[i]), i * (i + 1) + 1);
+    }
+
+    JSVMTEST_CALL(OH_JSVM_CallFunctionBatch(env, recv, func, 0, argc, nullptr, nullptr, &failedIndex));
+    ASSERT_EQ(failedIndex, 0u);
+}
+
+HWTEST_F(JSVMTest, JSVMCallFunctionBatchStopsOnException, TestSize.Level1)
+{
+    JSVM_Value func = jsvm::Run(R"JS(
+        globalThis.batchCalls = 0;
+        (function (a) {
+            batchCalls++;
+            if (a === 2) {
+                throw new Error('batch');
+            }
+            return a;
+        })
+    )JS");
+    JSVM_Value argv[] = { jsvm::Int32(0), jsvm::Int32(1), jsvm::Int32(2), jsvm::Int32(3) };
+    JSVM_Value results[4] = { nullptr };
+    size_t failedIndex = 0;
+    ASSERT_EQ(OH_JSVM_CallFunctionBatch(env, jsvm::Undefined(), func, 4, 1, argv, results, &failedIndex),
+              JSVM_PENDING_EXCEPTION);
+    ASSERT_EQ(failedIndex, 2u);
+    ASSERT_EQ(jsvm::ToNumber(results[1]), 1);
+
+    JSVM_Value exception = nullptr;
+    JSVMTEST_CALL(OH_JSVM_GetAndClearLastException(env, &exception));
+    ASSERT_FALSE(jsvm::IsUndefined(exception));
+    ASSERT_EQ(jsvm::ToNumber(jsvm::Global("batchCalls")), 3);
+}
+
+HWTEST_F(JSVMTest, JSVMCallFunctionBatchInvalidArgs, TestSize.Level1)
+{
+    JSVM_Value func = jsvm::Run("(function () {})");
+    JSVM_Value obj = jsvm::Object();
+    ASSERT_EQ(OH_JSVM_CallFunctionBatch(env, nullptr, func, 1, 0, nullptr, nullptr, nullptr), JSVM_INVALID_ARG);
+    ASSERT_EQ(OH_JSVM_CallFunctionBatch(env, obj, nullptr, 1, 0, nullptr, nullptr, nullptr), JSVM_INVALID_ARG);
+    ASSERT_EQ(OH_JSVM_CallFunctionBatch(env, obj, obj, 1, 0, nullptr, nullptr, nullptr), JSVM_INVALID_ARG);
+    ASSERT_EQ(OH_JSVM_CallFunctionBatch(env, obj, func, 1, 1, nullptr, nullptr, nullptr), JSVM_INVALID_ARG);
+}
+
+// OH_JSVM_PrepareCall tests
+HWTEST_F(JSVMTest, JSVMPrepareCall, TestSize.Level1)
+{
+    JSVM_Value func = jsvm::Run("(function (a, b) { return this.base + a + b; })");
+    JSVM_Value recv = jsvm::Run("({ base: 100 })");
+    JSVM_PreparedCall call = nullptr;
+    JSVMTEST_CALL(OH_JSVM_PrepareCall(env, func, recv, 2, &call));
+
+    for (int i = 0; i < 10; i++) {
+        JSVM_Value argv[] = { jsvm::Int32(i), jsvm::Int32(1) };
+        JSVM_Value result = nullptr;
+        JSVMTEST_CALL(OH_JSVM_InvokePrepared(env, call, argv, &result));
+        ASSERT_EQ(jsvm::ToNumber(result), 100 + i + 1);
+    }
+    JSVMTEST_CALL(OH_JSVM_ReleasePrepared(env, call));
+
+    // Without receiver the function is called with undefined as this.
+    JSVM_Value strictFunc = jsvm::Run("(function () { 'use strict'; return this === undefined; })");
+    JSVMTEST_CALL(OH_JSVM_PrepareCall(env, strictFunc, nullptr, 0, &call));
+    JSVM_Value result = nullptr;
+    JSVMTEST_CALL(OH_JSVM_InvokePrepared(env, call, nullptr, &result));
+    ASSERT_TRUE(jsvm::IsTrue(result));
+    JSVMTEST_CALL(OH_JSVM_ReleasePrepared(env, call));
+}
+
+HWTEST_F(JSVMTest, JSVMPrepareCallException, TestSize.Level1)
+{
+    JSVM_Value func = jsvm::Run("(function () { throw new Error('prepared'); })");
+    JSVM_PreparedCall call = nullptr;
+    JSVMTEST_CALL(OH_JSVM_PrepareCall(env, func, nullptr, 0, &call));
+    JSVM_Value result = nullptr;
+    ASSERT_EQ(OH_JSVM_InvokePrepared(env, call, nullptr, &result), JSVM_PENDING_EXCEPTION);
+    JSVM_Value exception = nullptr;
+    JSVMTEST_CALL(OH_JSVM_GetAndClearLastException(env, &exception));
+    ASSERT_FALSE(jsvm::IsUndefined(exception));
+    JSVMTEST_CALL(OH_JSVM_ReleasePrepared(env, call));
+}
+
+HWTEST_F(JSVMTest, JSVMPrepareCallInvalidArgs, TestSize.Level1)
+{
+    JSVM_PreparedCall call = nullptr;
+    JSVM_Value func = jsvm::Run("(function (a) {})");
+    ASSERT_EQ(OH_JSVM_PrepareCall(env, nullptr, nullptr, 0, &call), JSVM_INVALID_ARG);
+    ASSERT_EQ(OH_JSVM_PrepareCall(env, jsvm::Object(), nullptr, 0, &call), JSVM_INVALID_ARG);
+    ASSERT_EQ(OH_JSVM_PrepareCall(env, func, nullptr, 0, nullptr), JSVM_INVALID_ARG);
+    ASSERT_EQ(OH_JSVM_InvokePrepared(env, nullptr, nullptr, nullptr), JSVM_INVALID_ARG);
+    ASSERT_EQ(OH_JSVM_ReleasePrepared(env, nullptr), JSVM_INVALID_ARG);
+
+    JSVMTEST_CALL(OH_JSVM_PrepareCall(env, func, nullptr, 1, &call));
+    ASSERT_EQ(OH_JSVM_InvokePrepared(env, call, nullptr, nullptr), JSVM_INVALID_ARG);
+    JSVMTEST_CALL(OH_JSVM_ReleasePrepared(env, call));
+}
+
+// OH_JSVM_GetProperties / OH_JSVM_SetProperties tests
+HWTEST_F(JSVMTest, JSVMSetAndGetProperties, TestSize.Level1)
+{
+    JSVM_Value obj = jsvm::Object();
+    JSVM_Value keys[] = { jsvm::Str("x"), jsvm::Str("y"), jsvm::Str("name"), jsvm::Int32(0) };
+    JSVM_Value values[] = { jsvm::Int32(1), jsvm::Double(2.5), jsvm::Str("point"), jsvm::True() };
+    constexpr size_t count = sizeof(keys) / sizeof(keys[0]);
+    JSVMTEST_CALL(OH_JSVM_SetProperties(env, obj, count, keys, values));
+
+    jsvm::SetProperty(jsvm::Global(), "bulkObj", obj);
+    ASSERT_TRUE(
+        jsvm::IsTrue(jsvm::Run("bulkObj.x === 1 && bulkObj.y === 2.5 && bulkObj.name === 'point' && bulkObj[0]")));
+
+    JSVM_Value results[count] = { nullptr };
+    JSVMTEST_CALL(OH_JSVM_GetProperties(env, obj, count, keys, results));
+    for (size_t i = 0; i < count; i++) {
+        ASSERT_TRUE(jsvm::StrictEquals(results[i], values[i]));
+    }
+
+    JSVM_Value missingKey = jsvm::Str("missing");
+    JSVM_Value missing = nullptr;
+    JSVMTEST_CALL(OH_JSVM_GetProperties(env, obj, 1, &missingKey, &missing));
+    ASSERT_TRUE(jsvm::IsUndefined(missing));
+}
+
+HWTEST_F(JSVMTest, JSVMGetPropertiesException, TestSize.Level1)
+{
+    JSVM_Value obj = jsvm::Run("({ a: 1, get b() { throw new Error('getter'); }, c: 3 })");
+    JSVM_Value keys[] = { jsvm::Str("a"), jsvm::Str("b"), jsvm::Str("c") };
+    JSVM_Value results[3] = { nullptr };
+    ASSERT_EQ(OH_JSVM_GetProperties(env, obj, 3, keys, results), JSVM_PENDING_EXCEPTION);
+    ASSERT_EQ(jsvm::ToNumber(results[0]), 1);
+    ASSERT_EQ(results[2], nullptr);
+    JSVM_Value exception = nullptr;
+    JSVMTEST_CALL(OH_JSVM_GetAndClearLastException(env, &exception));
+}
+
+HWTEST_F(JSVMTest, JSVMGetSetPropertiesInvalidArgs, TestSize.Level1)
+{
+    JSVM_Value obj = jsvm::Object();
+    JSVM_Value key = jsvm::Str("k");
+    JSVM_Value nullKey = nullptr;
+    JSVM_Value value = nullptr;
+    ASSERT_EQ(OH_JSVM_GetProperties(env, obj, 1, nullptr, &value), JSVM_INVALID_ARG);
+    ASSERT_EQ(OH_JSVM_GetProperties(env, obj, 1, &key, nullptr), JSVM_INVALID_ARG);
+    ASSERT_EQ(OH_JSVM_GetProperties(env, obj, 1, &nullKey, &value), JSVM_INVALID_ARG);
+    ASSERT_EQ(OH_JSVM_SetProperties(env, obj, 1, &key, nullptr), JSVM_INVALID_ARG);
+    ASSERT_EQ(OH_JSVM_SetProperties(env, obj, 1, &key, &nullKey), JSVM_INVALID_ARG);
+    JSVMTEST_CALL(OH_JSVM_GetProperties(env, obj, 0, nullptr, nullptr));
+    JSVMTEST_CALL(OH_JSVM_SetProperties(env, obj, 0, nullptr, nullptr));
+}
+
+// OH_JSVM_CreatePropertyKey tests
+HWTEST_F(JSVMTest, JSVMPropertyKey, TestSize.Level1)
+{
+    JSVM_PropertyKey key = nullptr;
+    JSVMTEST_CALL(OH_JSVM_CreatePropertyKey(env, "counter", JSVM_AUTO_LENGTH, &key));
+
+    JSVM_Value obj = jsvm::Object();
+    bool hasProperty = true;
+    JSVMTEST_CALL(OH_JSVM_HasNamedPropertyByKey(env, obj, key, &hasProperty));
+    ASSERT_FALSE(hasProperty);
+
+    for (int i = 0; i < 100; i++) {
+        JSVMTEST_CALL(OH_JSVM_SetNamedPropertyByKey(env, obj, key, jsvm::Int32(i)));
+    }
+    JSVMTEST_CALL(OH_JSVM_HasNamedPropertyByKey(env, obj, key, &hasProperty));
+    ASSERT_TRUE(hasProperty);
+
+    JSVM_Value value = nullptr;
+    JSVMTEST_CALL(OH_JSVM_GetNamedPropertyByKey(env, obj, key, &value));
+    ASSERT_EQ(jsvm::ToNumber(value), 99);
+    ASSERT_EQ(jsvm::ToNumber(jsvm::GetProperty(obj, "counter")), 99);
+
+    JSVM_Value name = nullptr;
+    JSVMTEST_CALL(OH_JSVM_GetPropertyKeyValue(env, key, &name));
+    ASSERT_EQ(jsvm::ToString(name), "counter");
+    JSVM_Value results[1] = { nullptr };
+    JSVMTEST_CALL(OH_JSVM_GetProperties(env, obj, 1, &name, results));
+    ASSERT_EQ(jsvm::ToNumber(results[0]), 99);
+
+    JSVMTEST_CALL(OH_JSVM_ReleasePropertyKey(env, key));
+
+    // The length limits the name.
+    JSVMTEST_CALL(OH_JSVM_CreatePropertyKey(env, "counterXYZ", 7, &key));
+    JSVMTEST_CALL(OH_JSVM_GetNamedPropertyByKey(env, obj, key, &value));
+    ASSERT_EQ(jsvm::ToNumber(value), 99);
+    JSVMTEST_CALL(OH_JSVM_ReleasePropertyKey(env, key));
+}
+
+HWTEST_F(JSVMTest, JSVMPropertyKeyInvalidArgs, TestSize.Level1)
+{
+    JSVM_PropertyKey key = nullptr;
+    JSVM_Value value = nullptr;
+    bool hasProperty = false;
+    JSVM_Value obj = jsvm::Object();
+    ASSERT_EQ(OH_JSVM_CreatePropertyKey(env, nullptr, JSVM_AUTO_LENGTH, &key), JSVM_INVALID_ARG);
+    ASSERT_EQ(OH_JSVM_CreatePropertyKey(env, "k", JSVM_AUTO_LENGTH, nullptr), JSVM_INVALID_ARG);
+    ASSERT_EQ(OH_JSVM_ReleasePropertyKey(env, nullptr), JSVM_INVALID_ARG);
+    ASSERT_EQ(OH_JSVM_GetPropertyKeyValue(env, nullptr, &value), JSVM_INVALID_ARG);
+    ASSERT_EQ(OH_JSVM_SetNamedPropertyByKey(env, obj, nullptr, obj), JSVM_INVALID_ARG);
+    ASSERT_EQ(OH_JSVM_GetNamedPropertyByKey(env, obj, nullptr, &value), JSVM_INVALID_ARG);
+    ASSERT_EQ(OH_JSVM_HasNamedPropertyByKey(env, obj, nullptr, &hasProperty), JSVM_INVALID_ARG);
+}
+
+// OH_JSVM_CreateStructLayout tests
+struct TestPoint {
+    int32_t x;
+    double y;
+};
+
+struct TestRecord {
+    uint32_t id;
+    int64_t timestamp;
+    bool valid;
+    const char* label;
+    char code[8];
+    TestPoint point;
+};
+
+class StructLayoutScope {
+public:
+    explicit StructLayoutScope(JSVM_Env env) : env(env)
+    {
+        JSVM_StructField pointFields[] = {
+            { "x", offsetof(TestPoint, x), JSVM_FIELD_INT32, 0, nullptr },
+            { "y", offsetof(TestPoint, y), JSVM_FIELD_DOUBLE, 0, nullptr },
+        };
+        OH_JSVM_CreateStructLayout(env, 2, pointFields, &point);
+        JSVM_StructField recordFields[] = {
+            { "id", offsetof(TestRecord, id), JSVM_FIELD_UINT32, 0, nullptr },
+            { "timestamp", offsetof(TestRecord, timestamp), JSVM_FIELD_INT64, 0, nullptr },
+            { "valid", offsetof(TestRecord, valid), JSVM_FIELD_BOOL, 0, nullptr },
+            { "label", offsetof(TestRecord, label), JSVM_FIELD_UTF8, 0, nullptr },
+            { "code", offsetof(TestRecord, code), JSVM_FIELD_UTF8, sizeof(TestRecord::code), nullptr },
+            { "point", offsetof(TestRecord, point), JSVM_FIELD_STRUCT, 0, point },
+        };
+        OH_JSVM_CreateStructLayout(env, 6, recordFields, &record);
+    }
+
+    ~StructLayoutScope()
+    {
+        OH_JSVM_ReleaseStructLayout(env, record);
+        OH_JSVM_ReleaseStructLayout(env, point);
+    }
+
+    JSVM_Env env;
+    JSVM_StructLayout point = nullptr;
+    JSVM_StructLayout record = nullptr;
+};
+
+HWTEST_F(JSVMTest, JSVMStructToObject, TestSize.Level1)
+{
+    StructLayoutScope layouts(env);
+    ASSERT_NE(layouts.record, nullptr);
+
+    TestRecord record = { 7, 1700000000000, true, "first", "AB12", { -3, 0.25 } };
+    JSVM_Value obj = nullptr;
+    JSVMTEST_CALL(OH_JSVM_StructToObject(env, layouts.record, &record, &obj));
+    jsvm::SetProperty(jsvm::Global(), "record", obj);
+    ASSERT_TRUE(jsvm::IsTrue(jsvm::Run(R"JS(
+        record.id === 7 && record.timestamp === 1700000000000 && record.valid === true &&
+        record.label === 'first' && record.code === 'AB12' && record.point.x === -3 && record.point.y === 0.25
+    )JS")));
+
+    record.label = nullptr;
+    JSVM_Value other = nullptr;
+    JSVMTEST_CALL(OH_JSVM_StructToObject(env, layouts.record, &record, &other));
+    jsvm::SetProperty(jsvm::Global(), "other", other);
+    ASSERT_TRUE(jsvm::IsTrue(jsvm::Run("other.label === null")));
+    ASSERT_TRUE(jsvm::IsTrue(jsvm::Run("Object.keys(record).join() === Object.keys(other).join()")));
+}
+
+HWTEST_F(JSVMTest, JSVMObjectToStruct, TestSize.Level1)
+{
+    StructLayoutScope layouts(env);
+    JSVM_Value obj = jsvm::Run(R"JS(
+        ({ id: 42, timestamp: 2 ** 40, valid: true, label: 'ignored', code: 'TOOLONGCODE', point: { x: 5, y: 1.5 } })
+    )JS");
+
+    TestRecord record = {};
+    const char* label = "kept";
+    record.label = label;
+    JSVMTEST_CALL(OH_JSVM_ObjectToStruct(env, layouts.record, obj, &record));
+    ASSERT_EQ(record.id, 42u);
+    ASSERT_EQ(record.timestamp, int64_t { 1 } << 40);
+    ASSERT_TRUE(record.valid);
+    ASSERT_EQ(record.label, label);
+    ASSERT_STREQ(record.code, "TOOLONG");
+    ASSERT_EQ(record.point.x, 5);
+    ASSERT_EQ(record.point.y, 1.5);
+
+    JSVM_Value bad = jsvm::Run("({ id: 'x' })");
+    ASSERT_EQ(OH_JSVM_ObjectToStruct(env, layouts.record, bad, &record), JSVM_NUMBER_EXPECTED);
+    bad = jsvm::Run("({ id: 1, timestamp: 1, valid: true, code: '', point: 1 })");
+    ASSERT_EQ(OH_JSVM_ObjectToStruct(env, layouts.record, bad, &record), JSVM_OBJECT_EXPECTED);
+}
+
+HWTEST_F(JSVMTest, JSVMStructLayoutInvalidArgs, TestSize.Level1)
+{
+    JSVM_StructLayout layout = nullptr;
+    JSVM_StructField noName = { nullptr, 0, JSVM_FIELD_INT32, 0, nullptr };
+    JSVM_StructField noNested = { "s", 0, JSVM_FIELD_STRUCT, 0, nullptr };
+    JSVM_StructField badType = { "t", 0, static_cast<JSVM_StructFieldType>(100), 0, nullptr };
+    ASSERT_EQ(OH_JSVM_CreateStructLayout(env, 1, nullptr, &layout), JSVM_INVALID_ARG);
+    ASSERT_EQ(OH_JSVM_CreateStructLayout(env, 1, &noName, &layout), JSVM_INVALID_ARG);
+    ASSERT_EQ(OH_JSVM_CreateStructLayout(env, 1, &noNested, &layout), JSVM_INVALID_ARG);
+    ASSERT_EQ(OH_JSVM_CreateStructLayout(env, 1, &badType, &layout), JSVM_INVALID_ARG);
+    ASSERT_EQ(OH_JSVM_CreateStructLayout(env, 0, nullptr, nullptr), JSVM_INVALID_ARG);
+    ASSERT_EQ(OH_JSVM_ReleaseStructLayout(env, nullptr), JSVM_INVALID_ARG);
+
+    JSVM_Value obj = nullptr;
+    int data = 0;
+    ASSERT_EQ(OH_JSVM_StructToObject(env, nullptr, &data, &obj), JSVM_INVALID_ARG);
+    ASSERT_EQ(OH_JSVM_ObjectToStruct(env, nullptr, jsvm::Object(), &data), JSVM_INVALID_ARG);
+}
+
+// OH_JSVM_CreateArrayFromBuffer / OH_JSVM_CopyArrayToBuffer tests
+HWTEST_F(JSVMTest, JSVMArrayBufferRoundTrip, TestSize.Level1)
+{
+    constexpr size_t count = 100000;
+    std::vector<double> input(count);
+    for (size_t i = 0; i < count; ++i) {
+        input[i] = static_cast<double>(i) * 0.5;
+    }
+    JSVM_Value array = nullptr;
+    JSVMTEST_CALL(OH_JSVM_CreateArrayFromBuffer(env, JSVM_ELEMENT_DOUBLE, input.data(), count, &array));
+    jsvm::SetProperty(jsvm::Global(), "doubles", array);
+    ASSERT_TRUE(jsvm::IsTrue(jsvm::Run("doubles.length === 100000 && doubles[99999] === 49999.5")));
+
+    std::vector<double> output(count);
+    size_t copied = 0;
+    JSVMTEST_CALL(OH_JSVM_CopyArrayToBuffer(env, array, JSVM_ELEMENT_DOUBLE, output.data(), count, &copied));
+    ASSERT_EQ(copied, count);
+    ASSERT_EQ(input, output);
+
+    const int32_t ints[] = { -1, 0, 7 };
+    JSVMTEST_CALL(OH_JSVM_CreateArrayFromBuffer(env, JSVM_ELEMENT_INT32, ints, 3, &array));
+    uint32_t uints[2] = {};
+    JSVMTEST_CALL(OH_JSVM_CopyArrayToBuffer(env, array, JSVM_ELEMENT_UINT32, uints, 2, &copied));
+    ASSERT_EQ(copied, 2u);
+    ASSERT_EQ(uints[0], 0xffffffffu);
+    ASSERT_EQ(uints[1], 0u);
+
+    const bool flags[] = { true, false };
+    JSVMTEST_CALL(OH_JSVM_CreateArrayFromBuffer(env, JSVM_ELEMENT_BOOL, flags, 2, &array));
+    jsvm::SetProperty(jsvm::Global(), "flags", array);
+    ASSERT_TRUE(jsvm::IsTrue(jsvm::Run("flags[0] === true && flags[1] === false")));
+
+    JSVM_Value values[] = { jsvm::Str("a"), jsvm::Int32(1), jsvm::Object() };
+    JSVMTEST_CALL(OH_JSVM_CreateArrayFromBuffer(env, JSVM_ELEMENT_VALUE, values, 3, &array));
+    JSVM_Value read[3] = {};
+    JSVMTEST_CALL(OH_JSVM_CopyArrayToBuffer(env, array, JSVM_ELEMENT_VALUE, read, 3, &copied));
+    ASSERT_EQ(copied, 3u);
+    for (size_t i = 0; i < 3; ++i) {
+        ASSERT_TRUE(jsvm::StrictEquals(values[i], read[i]));
+    }
+}
+
+HWTEST_F(JSVMTest, JSVMCopyArrayToBufferMismatch, TestSize.Level1)
+{
+    JSVM_Value array = jsvm::Run("[1, 2, 'x', 4]");
+    int32_t ints[4] = {};
+    size_t copied = 0;
+    ASSERT_EQ(OH_JSVM_CopyArrayToBuffer(env, array, JSVM_ELEMENT_INT32, ints, 4, &copied), JSVM_NUMBER_EXPECTED);
+    ASSERT_EQ(copied, 2u);
+    ASSERT_EQ(ints[1], 2);
+
+    bool flags[4] = {};
+    ASSERT_EQ(OH_JSVM_CopyArrayToBuffer(env, array, JSVM_ELEMENT_BOOL, flags, 4, &copied), JSVM_BOOLEAN_EXPECTED);
+    ASSERT_EQ(copied, 0u);
+
+    ASSERT_EQ(OH_JSVM_CopyArrayToBuffer(env, jsvm::Object(), JSVM_ELEMENT_INT32, ints, 4, &copied),
+              JSVM_ARRAY_EXPECTED);
+}
+
+HWTEST_F(JSVMTest, JSVMArrayBufferInvalidArgs, TestSize.Level1)
+{
+    JSVM_Value array = nullptr;
+    int32_t ints[1] = {};
+    ASSERT_EQ(OH_JSVM_CreateArrayFromBuffer(env, JSVM_ELEMENT_INT32, nullptr, 1, &array), JSVM_INVALID_ARG);
+    ASSERT_EQ(OH_JSVM_CreateArrayFromBuffer(env, JSVM_ELEMENT_INT32, ints, 1, nullptr), JSVM_INVALID_ARG);
+    ASSERT_EQ(OH_JSVM_CreateArrayFromBuffer(env, static_cast<JSVM_ElementKind>(100), ints, 1, &array),
+              JSVM_INVALID_ARG);
+    // Lengths V8 can not back are rejected before the buffer is read.
+    constexpr size_t tooLong = 128 * 1024 * 1024;
+    ASSERT_EQ(OH_JSVM_CreateArrayFromBuffer(env, JSVM_ELEMENT_INT32, ints, tooLong, &array), JSVM_INVALID_ARG);
+    JSVM_Value values[2] = { jsvm::Int32(1), nullptr };
+    ASSERT_EQ(OH_JSVM_CreateArrayFromBuffer(env, JSVM_ELEMENT_VALUE, values, 2, &array), JSVM_INVALID_ARG);
+    JSVMTEST_CALL(OH_JSVM_CreateArrayFromBuffer(env, JSVM_ELEMENT_INT32, nullptr, 0, &array));
+    ASSERT_EQ(jsvm::ToNumber(jsvm::GetProperty(array, "length")), 0);
+
+    ASSERT_EQ(OH_JSVM_CopyArrayToBuffer(env, nullptr, JSVM_ELEMENT_INT32, ints, 1, nullptr), JSVM_INVALID_ARG);
+    ASSERT_EQ(OH_JSVM_CopyArrayToBuffer(env, array, JSVM_ELEMENT_INT32, nullptr, 1, nullptr), JSVM_INVALID_ARG);
+}
+
+// OH_JSVM_GetStringView tests
+HWTEST_F(JSVMTest, JSVMGetStringViewOneByte, TestSize.Level1)
+{
+    JSVM_Value str = jsvm::Run("'abc'.repeat(1000) + 'def'");
+    JSVM_StringView view = nullptr;
+    const void* data = nullptr;
+    size_t length = 0;
+    JSVM_StringEncoding encoding = JSVM_STRING_UTF16;
+    JSVMTEST_CALL(OH_JSVM_GetStringView(env, str, &view, &data, &length, &encoding));
+    ASSERT_EQ(encoding, JSVM_STRING_LATIN1);
+    ASSERT_EQ(length, 3003u);
+    const char* chars = static_cast<const char*>(data);
+    ASSERT_EQ(std::string(chars, 3), "abc");
+    ASSERT_EQ(std::string(chars + 3000, 3), "def");
+    JSVMTEST_CALL(OH_JSVM_ReleaseStringView(env, view));
+}
+
+HWTEST_F(JSVMTest, JSVMGetStringViewTwoByte, TestSize.Level1)
+{
+    JSVM_Value str = jsvm::Run("'\\u4f60\\u597d'");
+    JSVM_StringView view = nullptr;
+    const void* data = nullptr;
+    size_t length = 0;
+    JSVM_StringEncoding encoding = JSVM_STRING_LATIN1;
+    JSVMTEST_CALL(OH_JSVM_GetStringView(env, str, &view, &data, &length, &encoding));
+    ASSERT_EQ(encoding, JSVM_STRING_UTF16);
+    ASSERT_EQ(length, 2u);
+    ASSERT_EQ(std::u16string(static_cast<const char16_t*>(data), length), u"你好");
+    JSVMTEST_CALL(OH_JSVM_ReleaseStringView(env, view));
+}
+
+HWTEST_F(JSVMTest, JSVMGetStringViewInvalidArgs, TestSize.Level1)
+{
+    JSVM_StringView view = nullptr;
+    const void* data = nullptr;
+    size_t length = 0;
+    JSVM_StringEncoding encoding = JSVM_STRING_LATIN1;
+    ASSERT_EQ(OH_JSVM_GetStringView(env, jsvm::Int32(1), &view, &data, &length, &encoding), JSVM_STRING_EXPECTED);
+    ASSERT_EQ(OH_JSVM_GetStringView(env, nullptr, &view, &data, &length, &encoding), JSVM_INVALID_ARG);
+    ASSERT_EQ(OH_JSVM_GetStringView(env, jsvm::Str("a"), nullptr, &data, &length, &encoding), JSVM_INVALID_ARG);
+    ASSERT_EQ(OH_JSVM_ReleaseStringView(env, nullptr), JSVM_INVALID_ARG);
+}
+
+// OH_JSVM_SetStringCacheCapacity tests
+HWTEST_F(JSVMTest, JSVMStringCacheHits, TestSize.Level1)
+{
+    JSVMTEST_CALL(OH_JSVM_SetStringCacheCapacity(env, 8));
+    JSVM_Value first = nullptr;
+    JSVM_Value second = nullptr;
+    JSVMTEST_CALL(OH_JSVM_CreateStringUtf8(env, "status", JSVM_AUTO_LENGTH, &first));
+    JSVMTEST_CALL(OH_JSVM_CreateStringUtf8(env, "status", 6, &second));
+    ASSERT_TRUE(jsvm::StrictEquals(first, second));
+    ASSERT_EQ(jsvm::ToString(second), "status");
+
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    JSVMTEST_CALL(OH_JSVM_GetStringCacheStats(env, &hits, &misses));
+    ASSERT_EQ(hits, 1u);
+    ASSERT_EQ(misses, 1u);
+
+    std::string longString(100, 'x');
+    JSVMTEST_CALL(OH_JSVM_CreateStringUtf8(env, longString.c_str(), longString.size(), &first));
+    ASSERT_EQ(jsvm::ToString(first), longString);
+    JSVMTEST_CALL(OH_JSVM_GetStringCacheStats(env, &hits, &misses));
+    ASSERT_EQ(hits + misses, 2u);
+
+    JSVMTEST_CALL(OH_JSVM_SetStringCacheCapacity(env, 0));
+    JSVMTEST_CALL(OH_JSVM_CreateStringUtf8(env, "status", 6, &first));
+    JSVMTEST_CALL(OH_JSVM_GetStringCacheStats(env, &hits, &misses));
+    ASSERT_EQ(hits, 0u);
+    ASSERT_EQ(misses, 0u);
+}
+
+HWTEST_F(JSVMTest, JSVMStringCacheEviction, TestSize.Level1)
+{
+    JSVMTEST_CALL(OH_JSVM_SetStringCacheCapacity(env, 2));
+    JSVM_Value value = nullptr;
+    JSVMTEST_CALL(OH_JSVM_CreateStringUtf8(env, "a", 1, &value));
+    JSVMTEST_CALL(OH_JSVM_CreateStringUtf8(env, "b", 1, &value));
+    // Touch "a" so that "b" becomes the least recently used entry.
+    JSVMTEST_CALL(OH_JSVM_CreateStringUtf8(env, "a", 1, &value));
+    JSVMTEST_CALL(OH_JSVM_CreateStringUtf8(env, "c", 1, &value));
+    JSVMTEST_CALL(OH_JSVM_CreateStringUtf8(env, "a", 1, &value));
+    JSVMTEST_CALL(OH_JSVM_CreateStringUtf8(env, "b", 1, &value));
+    ASSERT_EQ(jsvm::ToString(value), "b");
+
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    JSVMTEST_CALL(OH_JSVM_GetStringCacheStats(env, &hits, &misses));
+    ASSERT_EQ(hits, 2u);
+    ASSERT_EQ(misses, 4u);
+    ASSERT_EQ(OH_JSVM_GetStringCacheStats(env, nullptr, &misses), JSVM_INVALID_ARG);
+    JSVMTEST_CALL(OH_JSVM_SetStringCacheCapacity(env, 0));
+}
+
+// ASCII fast path of OH_JSVM_CreateStringUtf8 / OH_JSVM_GetValueStringUtf8 tests
+HWTEST_F(JSVMTest, JSVMStringUtf8AsciiFastPath, TestSize.Level1)
+{
+    JSVM_Value str = nullptr;
+    JSVMTEST_CALL(OH_JSVM_CreateStringUtf8(env, "identifier_0123456789_abcdef", JSVM_AUTO_LENGTH, &str));
+    char buf[8] = {};
+    size_t length = 0;
+    JSVMTEST_CALL(OH_JSVM_GetValueStringUtf8(env, str, nullptr, 0, &length));
+    ASSERT_EQ(length, 28u);
+    JSVMTEST_CALL(OH_JSVM_GetValueStringUtf8(env, str, buf, sizeof(buf), &length));
+    ASSERT_EQ(length, 7u);
+    ASSERT_STREQ(buf, "identif");
+
+    // Latin-1 characters are stored as one byte but take two bytes in UTF-8.
+    str = jsvm::Run("'caf\\u00e9'");
+    JSVMTEST_CALL(OH_JSVM_GetValueStringUtf8(env, str, nullptr, 0, &length));
+    ASSERT_EQ(length, 5u);
+    JSVMTEST_CALL(OH_JSVM_GetValueStringUtf8(env, str, buf, sizeof(buf), &length));
+    ASSERT_EQ(length, 5u);
+    ASSERT_STREQ(buf, "caf\xc3\xa9");
+
+    JSVMTEST_CALL(OH_JSVM_CreateStringUtf8(env, "caf\xc3\xa9", JSVM_AUTO_LENGTH, &str));
+    jsvm::SetProperty(jsvm::Global(), "cafe", str);
+    ASSERT_TRUE(jsvm::IsTrue(jsvm::Run("cafe === 'caf\\u00e9'")));
+}
+
+// The fast path scans blocks of 8 or 16 bytes, a non-ASCII byte at any position must make it fall back.
+HWTEST_F(JSVMTest, JSVMStringUtf8AsciiFastPathBoundaries, TestSize.Level1)
+{
+    constexpr size_t maxLength = 40;
+    char buf[maxLength * 2 + 1] = {};
+    for (size_t length = 0; length <= maxLength; ++length) {
+        // The same ASCII input goes through the UTF-8 fast path and through the Latin-1 path.
+        std::string ascii(length, 'a');
+        JSVM_Value fast = nullptr;
+        JSVM_Value latin1 = nullptr;
+        JSVMTEST_CALL(OH_JSVM_CreateStringUtf8(env, ascii.data(), ascii.size(), &fast));
+        JSVMTEST_CALL(OH_JSVM_CreateStringLatin1(env, ascii.data(), ascii.size(), &latin1));
+        ASSERT_TRUE(jsvm::StrictEquals(fast, latin1));
+        size_t copied = 0;
+        JSVMTEST_CALL(OH_JSVM_GetValueStringUtf8(env, fast, buf, sizeof(buf), &copied));
+        ASSERT_EQ(std::string(buf, copied), ascii);
+
+        for (size_t pos = 0; pos < length; ++pos) {
+            // U+00E9 in UTF-8 replaces one ASCII character at pos.
+            std::string utf8 = ascii.substr(0, pos) + "\xc3\xa9" + ascii.substr(pos + 1);
+            JSVM_Value str = nullptr;
+            JSVMTEST_CALL(OH_JSVM_CreateStringUtf8(env, utf8.data(), utf8.size(), &str));
+            size_t strLength = 0;
+            JSVMTEST_CALL(OH_JSVM_GetValueStringUtf16(env, str, nullptr, 0, &strLength));
+            ASSERT_EQ(strLength, length);
+            JSVMTEST_CALL(OH_JSVM_GetValueStringUtf8(env, str, buf, sizeof(buf), &copied));
+            ASSERT_EQ(std::string(buf, copied), utf8);
+        }
+    }
+}
+
+// Microbenchmark of the ASCII fast path against the general path on the same input, only reports timing.
+HWTEST_F(JSVMTest, JSVMStringUtf8AsciiBenchmark, TestSize.Level1)
+{
+    constexpr int iterations = 10000;
+    const std::string ascii(1024, 'a');
+    std::vector<char> buf(ascii.size() + 1);
+    auto perIteration = [](std::chrono::steady_clock::time_point start) {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) /
+               iterations;
+    };
+
+    // Creation: the fast path scans the bytes and then copies them as Latin-1, which the Latin-1 API does
+    // without the scan, so the difference is the cost of the scan.
+    auto measureCreate = [&](JSVM_Status (*create)(JSVM_Env, const char*, size_t, JSVM_Value*)) {
+        JSVM_HandleScope scope;
+        OH_JSVM_OpenHandleScope(env, &scope);
+        JSVM_Value str = nullptr;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            create(env, ascii.data(), ascii.size(), &str);
+        }
+        double cost = perIteration(start);
+        OH_JSVM_CloseHandleScope(env, scope);
+        return cost;
+    };
+    double createUtf8Cost = measureCreate(OH_JSVM_CreateStringUtf8);
+    double createLatin1Cost = measureCreate(OH_JSVM_CreateStringLatin1);
+
+    // Extraction: a slice of a two-byte string holds the same characters, but is not one-byte, so it takes the
+    // general UTF-8 encoder.
+    JSVM_Value oneByte = nullptr;
+    JSVMTEST_CALL(OH_JSVM_CreateStringUtf8(env, ascii.data(), ascii.size(), &oneByte));
+    jsvm::SetProperty(jsvm::Global(), "asciiInput", oneByte);
+    JSVM_Value twoByte = jsvm::Run("('\\u0100' + asciiInput).slice(1)");
+    ASSERT_TRUE(jsvm::StrictEquals(oneByte, twoByte));
+    auto measureGet = [&](JSVM_Value str) {
+        size_t copied = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            OH_JSVM_GetValueStringUtf8(env, str, buf.data(), buf.size(), &copied);
+        }
+        double cost = perIteration(start);
+        EXPECT_EQ(std::string(buf.data(), copied), ascii);
+        return cost;
+    };
+    double getFastCost = measureGet(oneByte);
+    double getGeneralCost = measureGet(twoByte);
+
+    GTEST_LOG_(INFO) << "JSVMStringUtf8AsciiBenchmark: create utf8 " << createUtf8Cost << " ns, latin1 "
+                     << createLatin1Cost << " ns; get fast " << getFastCost << " ns, general " << getGeneralCost
+                     << " ns";
+}
+
+// OH_JSVM_GetValueStringUtf8Alloc tests
+HWTEST_F(JSVMTest, JSVMGetValueStringUtf8AllocCallback, TestSize.Level1)
+{
+    JSVM_Value str = jsvm::Run("'\\u4f60\\u597d, ' + 'world'.repeat(1000)");
+    std::vector<std::unique_ptr<char[]>> allocations;
+    auto allocate = [](size_t size, void* data) -> void* {
+        auto* allocations = static_cast<std::vector<std::unique_ptr<char[]>>*>(data);
+        allocations->emplace_back(new char[size]);
+        return allocations->back().get();
+    };
+    char* result = nullptr;
+    size_t length = 0;
+    JSVMTEST_CALL(OH_JSVM_GetValueStringUtf8Alloc(env, str, allocate, &allocations, &result, &length));
+    ASSERT_EQ(allocations.size(), 1u);
+    ASSERT_EQ(result, allocations[0].get());
+    std::string expected = "\xe4\xbd\xa0\xe5\xa5\xbd, ";
+    for (int i = 0; i < 1000; ++i) {
+        expected += "world";
+    }
+    ASSERT_EQ(length, expected.size());
+    ASSERT_EQ(std::string(result), expected);
+
+    auto failing = [](size_t, void*) -> void* { return nullptr; };
+    ASSERT_EQ(OH_JSVM_GetValueStringUtf8Alloc(env, str, failing, nullptr, &result, &length), JSVM_GENERIC_FAILURE);
+}
+
+HWTEST_F(JSVMTest, JSVMGetValueStringUtf8AllocExactSize, TestSize.Level1)
+{
+    static size_t requested = 0;
+    static char storage[64];
+    auto allocate = [](size_t size, void*) -> void* {
+        requested = size;
+        return storage;
+    };
+    char* result = nullptr;
+    size_t length = 0;
+    JSVMTEST_CALL(OH_JSVM_GetValueStringUtf8Alloc(env, jsvm::Str("ascii only"), allocate, nullptr, &result, &length));
+    ASSERT_EQ(length, 10u);
+    ASSERT_EQ(requested, length + 1);
+
+    // Latin-1, two-byte and unpaired surrogate characters take 2, 3 and 3 (replacement character) bytes.
+    JSVM_Value str = jsvm::Run("'caf\\u00e9 \\u4f60 \\ud800'");
+    JSVMTEST_CALL(OH_JSVM_GetValueStringUtf8Alloc(env, str, allocate, nullptr, &result, &length));
+    ASSERT_EQ(length, 13u);
+    ASSERT_EQ(requested, length + 1);
+    ASSERT_STREQ(result, "caf\xc3\xa9 \xe4\xbd\xa0 \xef\xbf\xbd");
+}
+
+HWTEST_F(JSVMTest, JSVMGetValueStringUtf8AllocScratch, TestSize.Level1)
+{
+    char* first = nullptr;
+    size_t length = 0;
+    JSVMTEST_CALL(OH_JSVM_GetValueStringUtf8Alloc(env, jsvm::Str("scratch"), nullptr, nullptr, &first, &length));
+    ASSERT_EQ(length, 7u);
+    ASSERT_STREQ(first, "scratch");
+
+    char* second = nullptr;
+    JSVMTEST_CALL(OH_JSVM_GetValueStringUtf8Alloc(env, jsvm::Str(""), nullptr, nullptr, &second, nullptr));
+    ASSERT_EQ(first, second);
+    ASSERT_STREQ(second, "");
+
+    ASSERT_EQ(OH_JSVM_GetValueStringUtf8Alloc(env, jsvm::Int32(1), nullptr, nullptr, &first, &length),
+              JSVM_STRING_EXPECTED);
+    ASSERT_EQ(OH_JSVM_GetValueStringUtf8Alloc(env, jsvm::Str("a"), nullptr, nullptr, nullptr, &length),
+              JSVM_INVALID_ARG);
+}
+
+// OH_JSVM_GetStringArrayUtf8 tests
+HWTEST_F(JSVMTest, JSVMGetStringArrayUtf8, TestSize.Level1)
+{
+    JSVM_Value array = jsvm::Run("['id', '', 'caf\\u00e9', '\\u4f60\\u597d', 'x'.repeat(100)]");
+    char* buffer = nullptr;
+    size_t offsets[6] = {};
+    JSVMTEST_CALL(OH_JSVM_GetStringArrayUtf8(env, array, nullptr, nullptr, &buffer, offsets, 6));
+
+    std::vector<std::string> expected = { "id", "", "caf\xc3\xa9", "\xe4\xbd\xa0\xe5\xa5\xbd", std::string(100, 'x') };
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(std::string(buffer + offsets[i], offsets[i + 1] - offsets[i]), expected[i]);
+    }
+    ASSERT_EQ(offsets[5], 113u);
+    ASSERT_EQ(buffer[offsets[5]], '\0');
+
+    JSVMTEST_CALL(OH_JSVM_GetStringArrayUtf8(env, jsvm::Run("[]"), nullptr, nullptr, &buffer, offsets, 1));
+    ASSERT_EQ(offsets[0], 0u);
+}
+
+// Each string is longer than all previous ones, so the scratch buffer grows while earlier strings are kept.
+HWTEST_F(JSVMTest, JSVMGetStringArrayUtf8ExactSize, TestSize.Level1)
+{
+    JSVM_Value array = jsvm::Run("['ab', '\\u4f60'.repeat(100), 'y'.repeat(10000)]");
+    static std::vector<char> storage;
+    auto allocate = [](size_t size, void*) -> void* {
+        storage.resize(size);
+        return storage.data();
+    };
+    char* buffer = nullptr;
+    size_t offsets[4] = {};
+    JSVMTEST_CALL(OH_JSVM_GetStringArrayUtf8(env, array, allocate, nullptr, &buffer, offsets, 4));
+    ASSERT_EQ(storage.size(), offsets[3] + 1);
+
+    std::string cjk;
+    for (int i = 0; i < 100; ++i) {
+        cjk += "\xe4\xbd\xa0";
+    }
+    std::vector<std::string> expected = { "ab", cjk, std::string(10000, 'y') };
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(std::string(buffer + offsets[i], offsets[i + 1] - offsets[i]), expected[i]);
+    }
+    ASSERT_EQ(buffer[offsets[3]], '\0');
+}
+
+HWTEST_F(JSVMTest, JSVMGetStringArrayUtf8InvalidArgs, TestSize.Level1)
+{
+    char* buffer = nullptr;
+    size_t offsets[3] = {};
+    JSVM_Value array = jsvm::Run("['a', 1]");
+    ASSERT_EQ(OH_JSVM_GetStringArrayUtf8(env, array, nullptr, nullptr, &buffer, offsets, 3), JSVM_STRING_EXPECTED);
+    ASSERT_EQ(OH_JSVM_GetStringArrayUtf8(env, array, nullptr, nullptr, &buffer, offsets, 2), JSVM_INVALID_ARG);
+    ASSERT_EQ(OH_JSVM_GetStringArrayUtf8(env, jsvm::Object(), nullptr, nullptr, &buffer, offsets, 3),
+              JSVM_ARRAY_EXPECTED);
+    ASSERT_EQ(OH_JSVM_GetStringArrayUtf8(env, array, nullptr, nullptr, nullptr, offsets, 3), JSVM_INVALID_ARG);
+
+    auto failing = [](size_t, void*) -> void* { return nullptr; };
+    ASSERT_EQ(OH_JSVM_GetStringArrayUtf8(env, jsvm::Run("['a']"), failing, nullptr, &buffer, offsets, 3),
+              JSVM_GENERIC_FAILURE);
+}
+
+// OH_JSVM_CreateExternalStringFromFile tests
+HWTEST_F(JSVMTest, JSVMCreateExternalStringFromFile, TestSize.Level1)
+{
+    const char* latin1Path = "/data/local/tmp/jsvm_external_latin1.js";
+    std::string source = "(function() { return 'mapped'; })()";
+    WriteBinaryFile(latin1Path, reinterpret_cast<const uint8_t*>(source.data()), source.size());
+    JSVM_Value str = nullptr;
+    bool copied = true;
+    JSVMTEST_CALL(OH_JSVM_CreateExternalStringFromFile(env, latin1Path, JSVM_STRING_LATIN1, &str, &copied));
+    ASSERT_EQ(jsvm::ToString(str), source);
+    JSVM_Script script = nullptr;
+    JSVMTEST_CALL(OH_JSVM_CompileScript(env, str, nullptr, 0, true, nullptr, &script));
+    JSVM_Value result = nullptr;
+    JSVMTEST_CALL(OH_JSVM_RunScript(env, script, &result));
+    ASSERT_EQ(jsvm::ToString(result), "mapped");
+
+    const char* utf16Path = "/data/local/tmp/jsvm_external_utf16.txt";
+    std::u16string text = u"你好";
+    WriteBinaryFile(utf16Path, reinterpret_cast<const uint8_t*>(text.data()), text.size() * sizeof(char16_t));
+    JSVMTEST_CALL(OH_JSVM_CreateExternalStringFromFile(env, utf16Path, JSVM_STRING_UTF16, &str, &copied));
+    jsvm::SetProperty(jsvm::Global(), "mapped", str);
+    ASSERT_TRUE(jsvm::IsTrue(jsvm::Run("mapped === '\\u4f60\\u597d'")));
+
+    const char* emptyPath = "/data/local/tmp/jsvm_external_empty.js";
+    WriteBinaryFile(emptyPath, nullptr, 0);
+    JSVMTEST_CALL(OH_JSVM_CreateExternalStringFromFile(env, emptyPath, JSVM_STRING_LATIN1, &str, &copied));
+    ASSERT_EQ(jsvm::ToString(str), "");
+}
+
+HWTEST_F(JSVMTest, JSVMCreateExternalStringFromFileInvalid, TestSize.Level1)
+{
+    JSVM_Value str = nullptr;
+    bool copied = false;
+    const char* utf8Path = "/data/local/tmp/jsvm_external_utf8.js";
+    std::string utf8 = "'caf\xc3\xa9'";
+    WriteBinaryFile(utf8Path, reinterpret_cast<const uint8_t*>(utf8.data()), utf8.size());
+    ASSERT_EQ(OH_JSVM_CreateExternalStringFromFile(env, utf8Path, JSVM_STRING_LATIN1, &str, &copied),
+              JSVM_INVALID_ARG);
+
+    const char* oddPath = "/data/local/tmp/jsvm_external_odd.txt";
+    WriteBinaryFile(oddPath, reinterpret_cast<const uint8_t*>("abc"), 3);
+    ASSERT_EQ(OH_JSVM_CreateExternalStringFromFile(env, oddPath, JSVM_STRING_UTF16, &str, &copied), JSVM_INVALID_ARG);
+
+    ASSERT_EQ(OH_JSVM_CreateExternalStringFromFile(env, "/data/local/tmp/jsvm_missing.js", JSVM_STRING_LATIN1, &str,
+                                                   &copied),
+              JSVM_GENERIC_FAILURE);
+    ASSERT_EQ(OH_JSVM_CreateExternalStringFromFile(env, nullptr, JSVM_STRING_LATIN1, &str, &copied),
+              JSVM_INVALID_ARG);
+}
+
+// OH_JSVM_DefineObjectShape tests
+HWTEST_F(JSVMTest, JSVMCreateObjectWithShape, TestSize.Level1)
+{
+    JSVM_Value symbol = jsvm::Run("globalThis.tag = Symbol('tag')");
+    JSVM_Value keys[] = { jsvm::Str("id"), jsvm::Str("name"), symbol };
+    JSVM_ObjectShape shape = nullptr;
+    JSVMTEST_CALL(OH_JSVM_DefineObjectShape(env, 3, keys, &shape));
+
+    JSVM_Value rows = nullptr;
+    JSVMTEST_CALL(OH_JSVM_CreateArray(env, &rows));
+    for (int32_t i = 0; i < 100; i++) {
+        JSVM_Value values[] = { jsvm::Int32(i), jsvm::Str("row"), jsvm::True() };
+        JSVM_Value row = nullptr;
+        JSVMTEST_CALL(OH_JSVM_CreateObjectWithShape(env, shape, values, &row));
+        JSVMTEST_CALL(OH_JSVM_SetElement(env, rows, i, row));
+    }
+    JSVMTEST_CALL(OH_JSVM_ReleaseObjectShape(env, shape));
+
+    jsvm::SetProperty(jsvm::Global(), "rows", rows);
+    ASSERT_TRUE(jsvm::IsTrue(jsvm::Run(R"JS(
+        rows.every((row, i) => row.id === i && row.name === 'row' && row[tag] === true) &&
+        Object.keys(rows[0]).join() === 'id,name' &&
+        Object.getOwnPropertyDescriptor(rows[1], 'id').writable
+    )JS")));
+}
+
+HWTEST_F(JSVMTest, JSVMObjectShapeInvalidArgs, TestSize.Level1)
+{
+    JSVM_ObjectShape shape = nullptr;
+    JSVM_Value duplicate[] = { jsvm::Str("a"), jsvm::Str("a") };
+    ASSERT_EQ(OH_JSVM_DefineObjectShape(env, 2, duplicate, &shape), JSVM_INVALID_ARG);
+    JSVM_Value notName[] = { jsvm::Int32(1) };
+    ASSERT_EQ(OH_JSVM_DefineObjectShape(env, 1, notName, &shape), JSVM_NAME_EXPECTED);
+    ASSERT_EQ(OH_JSVM_DefineObjectShape(env, 1, nullptr, &shape), JSVM_INVALID_ARG);
+    ASSERT_EQ(OH_JSVM_ReleaseObjectShape(env, nullptr), JSVM_INVALID_ARG);
+
+    JSVMTEST_CALL(OH_JSVM_DefineObjectShape(env, 0, nullptr, &shape));
+    JSVM_Value obj = nullptr;
+    JSVMTEST_CALL(OH_JSVM_CreateObjectWithShape(env, shape, nullptr, &obj));
+    ASSERT_EQ(OH_JSVM_CreateObjectWithShape(env, shape, nullptr, nullptr), JSVM_INVALID_ARG);
+    ASSERT_EQ(OH_JSVM_CreateObjectWithShape(env, nullptr, nullptr, &obj), JSVM_INVALID_ARG);
+    JSVMTEST_CALL(OH_JSVM_ReleaseObjectShape(env, shape));
+}
+
+// OH_JSVM_ArrayForEach tests
+HWTEST_F(JSVMTest, JSVMArrayForEach, TestSize.Level1)
+{
+    JSVM_Value array = jsvm::Run("[1.5, 2, , 4]");
+    struct Visit {
+        std::vector<uint32_t> indices;
+        double sum = 0;
+        uint32_t undefinedCount = 0;
+    } visit;
+    JSVMTEST_CALL(OH_JSVM_ArrayForEach(
+        env, array,
+        [](JSVM_Env env, uint32_t index, JSVM_Value element, void* data) {
+            auto* visit = static_cast<Visit*>(data);
+            visit->indices.push_back(index);
+            JSVM_ValueType type;
+            OH_JSVM_TypeOf(env, element, &type);
+            if (type == JSVM_NUMBER) {
+                double value = 0;
+                OH_JSVM_GetValueDouble(env, element, &value);
+                visit->sum += value;
+            } else if (type == JSVM_UNDEFINED) {
+                visit->undefinedCount++;
+            }
+            return true;
+        },
+        &visit));
+    ASSERT_EQ(visit.indices, (std::vector<uint32_t> { 0, 1, 2, 3 }));
+    ASSERT_EQ(visit.sum, 7.5);
+    ASSERT_EQ(visit.undefinedCount, 1u);
+}
+
+HWTEST_F(JSVMTest, JSVMArrayForEachEarlyStop, TestSize.Level1)
+{
+    JSVM_Value array = jsvm::Run("Array.from({ length: 1000 }, (_, i) => i)");
+    uint32_t visited = 0;
+    JSVMTEST_CALL(OH_JSVM_ArrayForEach(
+        env, array,
+        [](JSVM_Env env, uint32_t index, JSVM_Value element, void* data) {
+            ++*static_cast<uint32_t*>(data);
+            return index < 9;
+        },
+        &visited));
+    ASSERT_EQ(visited, 10u);
+
+    auto callback = [](JSVM_Env, uint32_t, JSVM_Value, void*) { return true; };
+    ASSERT_EQ(OH_JSVM_ArrayForEach(env, jsvm::Object(), callback, nullptr), JSVM_ARRAY_EXPECTED);
+    ASSERT_EQ(OH_JSVM_ArrayForEach(env, array, nullptr, nullptr), JSVM_INVALID_ARG);
+    ASSERT_EQ(OH_JSVM_ArrayForEach(env, nullptr, callback, nullptr), JSVM_INVALID_ARG);
+}
+
+// OH_JSVM_GetOwnKeysUtf8 tests
+HWTEST_F(JSVMTest, JSVMGetOwnKeysUtf8, TestSize.Level1)
+{
+    JSVM_Value first = jsvm::Run("({ id: 1, 'caf\\u00e9': 2, [Symbol()]: 3 })");
+    const JSVM_KeyName* keys = nullptr;
+    size_t count = 0;
+    JSVMTEST_CALL(OH_JSVM_GetOwnKeysUtf8(env, first, &keys, &count));
+    ASSERT_EQ(count, 2u);
+    ASSERT_EQ(std::string(keys[0].data, keys[0].length), "id");
+    ASSERT_STREQ(keys[1].data, "caf\xc3\xa9");
+
+    // A longer list than the previous one grows the buffer of the env.
+    JSVM_Value second = jsvm::Run("({ ['\\u4f60'.repeat(100)]: 1, id: 7, 'caf\\u00e9': 8 })");
+    JSVMTEST_CALL(OH_JSVM_GetOwnKeysUtf8(env, second, &keys, &count));
+    ASSERT_EQ(count, 3u);
+    ASSERT_EQ(keys[0].length, 300u);
+    ASSERT_STREQ(keys[1].data, "id");
+    ASSERT_STREQ(keys[2].data, "caf\xc3\xa9");
+
+    JSVM_Value indexed = jsvm::Run("({ 2: 'a', 10: 'b', name: 'c' })");
+    JSVMTEST_CALL(OH_JSVM_GetOwnKeysUtf8(env, indexed, &keys, &count));
+    ASSERT_EQ(count, 3u);
+    ASSERT_STREQ(keys[0].data, "2");
+    ASSERT_STREQ(keys[1].data, "10");
+    ASSERT_STREQ(keys[2].data, "name");
+}
+
+HWTEST_F(JSVMTest, JSVMGetOwnKeysUtf8InvalidArgs, TestSize.Level1)
+{
+    const JSVM_KeyName* keys = nullptr;
+    size_t count = 1;
+    JSVMTEST_CALL(OH_JSVM_GetOwnKeysUtf8(env, jsvm::Object(), &keys, &count));
+    ASSERT_EQ(count, 0u);
+    ASSERT_EQ(OH_JSVM_GetOwnKeysUtf8(env, nullptr, &keys, &count), JSVM_INVALID_ARG);
+    ASSERT_EQ(OH_JSVM_GetOwnKeysUtf8(env, jsvm::Object(), nullptr, &count), JSVM_INVALID_ARG);
+    ASSERT_EQ(OH_JSVM_GetOwnKeysUtf8(env, jsvm::Object(), &keys, nullptr), JSVM_INVALID_ARG);
+}
+
+// OH_JSVM_JsonParseUtf8 / OH_JSVM_JsonParseExternalLatin1 tests
+HWTEST_F(JSVMTest, JSVMJsonParseUtf8, TestSize.Level1)
+{
+    const char* json = "{\"id\": 1, \"name\": \"caf\xc3\xa9\", \"tags\": [\"a\", \"\xe4\xbd\xa0\"]}";
+    JSVM_Value result = nullptr;
+    JSVMTEST_CALL(OH_JSVM_JsonParseUtf8(env, json, JSVM_AUTO_LENGTH, &result));
+    jsvm::SetProperty(jsvm::Global(), "parsed", result);
+    ASSERT_TRUE(jsvm::IsTrue(
+        jsvm::Run("parsed.id === 1 && parsed.name === 'caf\\u00e9' && parsed.tags[1] === '\\u4f60'")));
+
+    JSVMTEST_CALL(OH_JSVM_JsonParseUtf8(env, "[\"ascii only\"]", JSVM_AUTO_LENGTH, &result));
+    JSVM_Value element = nullptr;
+    JSVMTEST_CALL(OH_JSVM_GetElement(env, result, 0, &element));
+    ASSERT_EQ(jsvm::ToString(element), "ascii only");
+
+    const char* number = "42 trailing";
+    JSVMTEST_CALL(OH_JSVM_JsonParseUtf8(env, number, 2, &result));
+    ASSERT_EQ(jsvm::ToNumber(result), 42);
+
+    ASSERT_EQ(OH_JSVM_JsonParseUtf8(env, "{bad", JSVM_AUTO_LENGTH, &result), JSVM_PENDING_EXCEPTION);
+    JSVM_Value exception = nullptr;
+    JSVMTEST_CALL(OH_JSVM_GetAndClearLastException(env, &exception));
+    ASSERT_EQ(OH_JSVM_JsonParseUtf8(env, nullptr, 1, &result), JSVM_INVALID_ARG);
+    ASSERT_EQ(OH_JSVM_JsonParseUtf8(env, "1", 1, nullptr), JSVM_INVALID_ARG);
+}
+
+HWTEST_F(JSVMTest, JSVMJsonParseExternalLatin1, TestSize.Level1)
+{
+    static bool finalized = false;
+    std::string text = R"({"rows": [{"label": "a much longer string value"}, {"label": "second"}]})";
+    char* data = new char[text.size()];
+    memcpy(data, text.data(), text.size());
+    JSVM_Value result = nullptr;
+    bool copied = false;
+    JSVMTEST_CALL(OH_JSVM_JsonParseExternalLatin1(
+        env, data, text.size(),
+        [](JSVM_Env, void* data, void*) {
+            delete[] static_cast<char*>(data);
+            finalized = true;
+        },
+        nullptr, &result, &copied));
+    jsvm::SetProperty(jsvm::Global(), "external", result);
+    ASSERT_TRUE(jsvm::IsTrue(jsvm::Run("external.rows[0].label === 'a much longer string value'")));
+    ASSERT_EQ(finalized, copied);
+
+    ASSERT_EQ(OH_JSVM_JsonParseExternalLatin1(env, nullptr, 0, nullptr, nullptr, &result, nullptr),
+              JSVM_INVALID_ARG);
+}
+
+// OH_JSVM_JsonStringifyToStream tests
+struct JsonStreamSink {
+    std::string text;
+    int chunks = 0;
+    bool ended = false;
+    int abortAfter = -1;
+};
+
+static bool CollectJsonChunk(const char* data, int size, void* streamData)
+{
+    auto* sink = static_cast<JsonStreamSink*>(streamData);
+    if (data == nullptr) {
+        sink->ended = true;
+        return true;
+    }
+    sink->text.append(data, size);
+    return ++sink->chunks != sink->abortAfter;
+}
+
+HWTEST_F(JSVMTest, JSVMJsonStringifyToStream, TestSize.Level1)
+{
+    JSVM_Value value = jsvm::Run("({ name: 'caf\\u00e9', emoji: '\\ud83d\\ude00', cjk: '\\u4f60', n: [1, 2] })");
+    JsonStreamSink sink;
+    JSVMTEST_CALL(OH_JSVM_JsonStringifyToStream(env, value, CollectJsonChunk, &sink));
+    ASSERT_TRUE(sink.ended);
+    ASSERT_EQ(sink.text, "{\"name\":\"caf\xc3\xa9\",\"emoji\":\"\xf0\x9f\x98\x80\","
+                         "\"cjk\":\"\xe4\xbd\xa0\",\"n\":[1,2]}");
+
+    // Larger than a chunk, so the text arrives in pieces.
+    JSVM_Value large = jsvm::Run("Array.from({ length: 20000 }, (_, i) => ({ id: i, label: 'item\\u00e9' + i }))");
+    JSVM_Value expected = nullptr;
+    JSVMTEST_CALL(OH_JSVM_JsonStringify(env, large, &expected));
+    JsonStreamSink largeSink;
+    JSVMTEST_CALL(OH_JSVM_JsonStringifyToStream(env, large, CollectJsonChunk, &largeSink));
+    ASSERT_GT(largeSink.chunks, 1);
+    ASSERT_EQ(largeSink.text, jsvm::ToString(expected));
+}
+
+HWTEST_F(JSVMTest, JSVMJsonStringifyToStreamAbort, TestSize.Level1)
+{
+    JSVM_Value large = jsvm::Run("'x'.repeat(200000)");
+    JsonStreamSink sink;
+    sink.abortAfter = 1;
+    ASSERT_EQ(OH_JSVM_JsonStringifyToStream(env, large, CollectJsonChunk, &sink), JSVM_CANCELLED);
+    ASSERT_EQ(sink.chunks, 1);
+    ASSERT_FALSE(sink.ended);
+
+    JSVM_Value cyclic = jsvm::Run("var cyclic = {}; cyclic.self = cyclic; cyclic");
+    ASSERT_EQ(OH_JSVM_JsonStringifyToStream(env, cyclic, CollectJsonChunk, &sink), JSVM_PENDING_EXCEPTION);
+    JSVM_Value exception = nullptr;
+    JSVMTEST_CALL(OH_JSVM_GetAndClearLastException(env, &exception));
+
+    ASSERT_EQ(OH_JSVM_JsonStringifyToStream(env, nullptr, CollectJsonChunk, &sink), JSVM_INVALID_ARG);
+    ASSERT_EQ(OH_JSVM_JsonStringifyToStream(env, large, nullptr, &sink), JSVM_INVALID_ARG);
+}
+
+// JSVM_DEFINE_CLASS_WITH_WRAPPER_FIELD tests
+static JSVM_Value DefineWrapperFieldClass(JSVM_Env env, const char* name)
+{
+    static JSVM_CallbackStruct constructor = {
+        .callback = [](JSVM_Env env, JSVM_CallbackInfo info) -> JSVM_Value {
+            JSVM_Value thisVar = nullptr;
+            OH_JSVM_GetCbInfo(env, info, nullptr, nullptr, &thisVar, nullptr);
+            return thisVar;
+        },
+        .data = nullptr,
+    };
+    JSVM_DefineClassOptions options[1];
+    options[0].id = JSVM_DEFINE_CLASS_WITH_WRAPPER_FIELD;
+    options[0].content.ptr = nullptr;
+    JSVM_Value cls = nullptr;
+    JSVMTEST_CALL(OH_JSVM_DefineClassWithOptions(env, name, JSVM_AUTO_LENGTH, &constructor, 0, nullptr, nullptr, 1,
+                                                 options, &cls));
+    jsvm::SetProperty(jsvm::Global(), name, cls);
+    return cls;
+}
+
+HWTEST_F(JSVMTest, JSVMWrapperFieldClassWrap, TestSize.Level1)
+{
+    DefineWrapperFieldClass(env, "WrapperFieldPoint");
+    JSVM_Value instance = jsvm::Run("new WrapperFieldPoint()");
+    int32_t native = 0;
+    void* result = nullptr;
+    ASSERT_EQ(OH_JSVM_Unwrap(env, instance, &result), JSVM_INVALID_ARG);
+
+    JSVMTEST_CALL(OH_JSVM_Wrap(env, instance, &native, nullptr, nullptr, nullptr));
+    JSVMTEST_CALL(OH_JSVM_Unwrap(env, instance, &result));
+    ASSERT_EQ(result, &native);
+    ASSERT_EQ(OH_JSVM_Wrap(env, instance, &native, nullptr, nullptr, nullptr), JSVM_INVALID_ARG);
+
+    result = nullptr;
+    JSVMTEST_CALL(OH_JSVM_RemoveWrap(env, instance, &result));
+    ASSERT_EQ(result, &native);
+    ASSERT_EQ(OH_JSVM_Unwrap(env, instance, &result), JSVM_INVALID_ARG);
+    ASSERT_EQ(OH_JSVM_Wrap(env, instance, nullptr, nullptr, nullptr, nullptr), JSVM_INVALID_ARG);
+
+    // Instances of JavaScript subclasses are created from the same instance template.
+    JSVM_Value derived = jsvm::Run("class DerivedPoint extends WrapperFieldPoint {}; new DerivedPoint()");
+    JSVMTEST_CALL(OH_JSVM_Wrap(env, derived, &native, nullptr, nullptr, nullptr));
+    JSVMTEST_CALL(OH_JSVM_Unwrap(env, derived, &result));
+    ASSERT_EQ(result, &native);
+}
+
+HWTEST_F(JSVMTest, JSVMWrapperFieldClassFinalizer, TestSize.Level1)
+{
+    static int finalized = 0;
+    DefineWrapperFieldClass(env, "WrapperFieldFinalized");
+    JSVM_Value instance = jsvm::Run("new WrapperFieldFinalized()");
+    int32_t native = 0;
+    JSVM_Ref ref = nullptr;
+    JSVMTEST_CALL(OH_JSVM_Wrap(
+        env, instance, &native, [](JSVM_Env, void*, void*) { finalized++; }, nullptr, &ref));
+    ASSERT_NE(ref, nullptr);
+    JSVM_Value referenced = nullptr;
+    JSVMTEST_CALL(OH_JSVM_GetReferenceValue(env, ref, &referenced));
+    ASSERT_TRUE(jsvm::StrictEquals(referenced, instance));
+    JSVMTEST_CALL(OH_JSVM_DeleteReference(env, ref));
+
+    // Removing the wrap drops the finalizer without running it.
+    void* result = nullptr;
+    JSVMTEST_CALL(OH_JSVM_RemoveWrap(env, instance, &result));
+    ASSERT_EQ(result, &native);
+    ASSERT_EQ(finalized, 0);
+
+    // Objects without the wrapper fields still use the private property.
+    JSVM_Value plain = jsvm::Object();
+    JSVMTEST_CALL(OH_JSVM_Wrap(env, plain, nullptr, nullptr, nullptr, nullptr));
+    JSVMTEST_CALL(OH_JSVM_Unwrap(env, plain, &result));
+    ASSERT_EQ(result, nullptr);
+}
+
+HWTEST_F(JSVMTest, JSVMWrapperFieldClassTypeTag, TestSize.Level1)
+{
+    static const JSVM_TypeTag pointTag = { 0x9e4b2449547061b3, 0x33999f8a6516c499 };
+    static const JSVM_TypeTag otherTag = { 0x9e4b2449547061b3, 0x33999f8a6516c498 };
+    DefineWrapperFieldClass(env, "WrapperFieldTagged");
+    JSVM_Value instance = jsvm::Run("new WrapperFieldTagged()");
+    bool result = true;
+    JSVMTEST_CALL(OH_JSVM_CheckObjectTypeTag(env, instance, &pointTag, &result));
+    ASSERT_FALSE(result);
+
+    JSVMTEST_CALL(OH_JSVM_TypeTagObject(env, instance, &pointTag));
+    JSVMTEST_CALL(OH_JSVM_CheckObjectTypeTag(env, instance, &pointTag, &result));
+    ASSERT_TRUE(result);
+    JSVMTEST_CALL(OH_JSVM_CheckObjectTypeTag(env, instance, &otherTag, &result));
+    ASSERT_FALSE(result);
+    ASSERT_EQ(OH_JSVM_TypeTagObject(env, instance, &otherTag), JSVM_INVALID_ARG);
+
+    // Instances with equal tags share the interned copy, and a copy of the tag still matches.
+    JSVM_Value second = jsvm::Run("new WrapperFieldTagged()");
+    JSVMTEST_CALL(OH_JSVM_TypeTagObject(env, second, &pointTag));
+    JSVM_TypeTag copy = pointTag;
+    JSVMTEST_CALL(OH_JSVM_CheckObjectTypeTag(env, second, &copy, &result));
+    ASSERT_TRUE(result);
+
+    // Objects without the wrapper fields keep the tag in the private property.
+    JSVM_Value plain = jsvm::Object();
+    JSVMTEST_CALL(OH_JSVM_TypeTagObject(env, plain, &pointTag));
+    JSVMTEST_CALL(OH_JSVM_CheckObjectTypeTag(env, plain, &pointTag, &result));
+    ASSERT_TRUE(result);
+}
+
+// JSVM_DEFINE_CLASS_WITH_ID tests
+static JSVM_Env g_sharedClassEnv = nullptr;
+
+static JSVM_Value SharedClassConstructor(JSVM_Env env, JSVM_CallbackInfo info)
+{
+    g_sharedClassEnv = env;
+    JSVM_Value thisVar = nullptr;
+    OH_JSVM_GetCbInfo(env, info, nullptr, nullptr, &thisVar, nullptr);
+    return thisVar;
+}
+
+static JSVM_Value SharedClassDescribe(JSVM_Env env, JSVM_CallbackInfo info)
+{
+    g_sharedClassEnv = env;
+    JSVM_Value result = nullptr;
+    OH_JSVM_CreateStringUtf8(env, "shared", JSVM_AUTO_LENGTH, &result);
+    return result;
+}
+
+static JSVM_Value DefineSharedClass(JSVM_Env env, int classId, JSVM_Callback constructor, JSVM_Value parentClass)
+{
+    static JSVM_CallbackStruct describe = { SharedClassDescribe, nullptr };
+    JSVM_Value kind = nullptr;
+    JSVMTEST_CALL(OH_JSVM_CreateInt32(env, classId, &kind));
+    JSVM_PropertyDescriptor properties[] = {
+        { "describe", nullptr, &describe, nullptr, nullptr, nullptr, JSVM_DEFAULT },
+        { "kind", nullptr, nullptr, nullptr, nullptr, kind, JSVM_STATIC },
+    };
+    JSVM_DefineClassOptions options[1];
+    options[0].id = JSVM_DEFINE_CLASS_WITH_ID;
+    options[0].content.num = classId;
+    JSVM_Value cls = nullptr;
+    JSVMTEST_CALL(OH_JSVM_DefineClassWithOptions(env, "SharedClass", JSVM_AUTO_LENGTH, constructor, 2, properties,
+                                                 parentClass, 1, options, &cls));
+    return cls;
+}
+
+HWTEST_F(JSVMTest, JSVMDefineClassWithId, TestSize.Level1)
+{
+    static JSVM_CallbackStruct constructor = { SharedClassConstructor, nullptr };
+    static bool otherCalled = false;
+    static JSVM_CallbackStruct otherConstructor = {
+        [](JSVM_Env env, JSVM_CallbackInfo info) -> JSVM_Value {
+            otherCalled = true;
+            return nullptr;
+        },
+        nullptr,
+    };
+    JSVM_Value cls = DefineSharedClass(env, 1, &constructor, nullptr);
+    JSVM_Value instance = nullptr;
+    JSVMTEST_CALL(OH_JSVM_NewInstance(env, cls, 0, nullptr, &instance));
+    ASSERT_EQ(g_sharedClassEnv, env);
+
+    JSVM_Env env2 = nullptr;
+    JSVM_EnvScope envScope2 = nullptr;
+    JSVM_HandleScope handleScope2 = nullptr;
+    JSVMTEST_CALL(OH_JSVM_CreateEnv(vm, 0, nullptr, &env2));
+    JSVMTEST_CALL(OH_JSVM_OpenEnvScope(env2, &envScope2));
+    JSVMTEST_CALL(OH_JSVM_OpenHandleScope(env2, &handleScope2));
+
+    // The second env instantiates the template of the first definition, but its callbacks see env2.
+    JSVM_Value cls2 = DefineSharedClass(env2, 1, &otherConstructor, nullptr);
+    JSVM_Value instance2 = nullptr;
+    JSVMTEST_CALL(OH_JSVM_NewInstance(env2, cls2, 0, nullptr, &instance2));
+    ASSERT_EQ(g_sharedClassEnv, env2);
+    ASSERT_FALSE(otherCalled);
+
+    JSVM_Value describe = nullptr;
+    JSVM_Value described = nullptr;
+    g_sharedClassEnv = nullptr;
+    JSVMTEST_CALL(OH_JSVM_GetNamedProperty(env2, instance2, "describe", &describe));
+    JSVMTEST_CALL(OH_JSVM_CallFunction(env2, instance2, describe, 0, nullptr, &described));
+    ASSERT_EQ(g_sharedClassEnv, env2);
+    char buf[16];
+    size_t copied = 0;
+    JSVMTEST_CALL(OH_JSVM_GetValueStringUtf8(env2, described, buf, sizeof(buf), &copied));
+    ASSERT_STREQ(buf, "shared");
+
+    // Static properties are still defined in each env.
+    JSVM_Value kind = nullptr;
+    int32_t kindValue = 0;
+    JSVMTEST_CALL(OH_JSVM_GetNamedProperty(env2, cls2, "kind", &kind));
+    JSVMTEST_CALL(OH_JSVM_GetValueInt32(env2, kind, &kindValue));
+    ASSERT_EQ(kindValue, 1);
+
+    JSVMTEST_CALL(OH_JSVM_CloseHandleScope(env2, handleScope2));
+    JSVMTEST_CALL(OH_JSVM_CloseEnvScope(env2, envScope2));
+    JSVMTEST_CALL(OH_JSVM_DestroyEnv(env2));
+}
+
+HWTEST_F(JSVMTest, JSVMDefineClassWithIdNotShared, TestSize.Level1)
+{
+    static JSVM_CallbackStruct constructor = { SharedClassConstructor, nullptr };
+    static int otherCalls = 0;
+    static JSVM_CallbackStruct otherConstructor = {
+        [](JSVM_Env env, JSVM_CallbackInfo info) -> JSVM_Value {
+            otherCalls++;
+            JSVM_Value thisVar = nullptr;
+            OH_JSVM_GetCbInfo(env, info, nullptr, nullptr, &thisVar, nullptr);
+            return thisVar;
+        },
+        nullptr,
+    };
+    // Classes with a parent class are built anew on each definition.
+    JSVM_Value parent = GenerateParentClass(env);
+    DefineSharedClass(env, 2, &constructor, parent);
+    JSVM_Value cls = DefineSharedClass(env, 2, &otherConstructor, parent);
+    JSVM_Value instance = nullptr;
+    JSVMTEST_CALL(OH_JSVM_NewInstance(env, cls, 0, nullptr, &instance));
+    ASSERT_EQ(otherCalls, 1);
+}
+
+// JSVM_DEFINE_CLASS_WITH_NATIVE_ELEMENTS tests
+template<typename T>
+static bool VectorElements(void* nativeObject, void** elements, size_t* length)
+{
+    auto* vec = static_cast<std::vector<T>*>(nativeObject);
+    *elements = vec->data();
+    *length = vec->size();
+    return true;
+}
+
+// Constructor of native elements classes, wraps the vector passed as callback data.
+static JSVM_Value WrapVector(JSVM_Env env, JSVM_CallbackInfo info)
+{
+    JSVM_Value thisVar = nullptr;
+    void* data = nullptr;
+    OH_JSVM_GetCbInfo(env, info, nullptr, nullptr, &thisVar, &data);
+    OH_JSVM_Wrap(env, thisVar, data, nullptr, nullptr, nullptr);
+    return thisVar;
+}
+
+static JSVM_Value DefineNativeElementsClass(JSVM_Env env,
+                                            const char* name,
+                                            JSVM_CallbackStruct* constructor,
+                                            JSVM_NativeElements* elements)
+{
+    JSVM_DefineClassOptions options[2];
+    options[0].id = JSVM_DEFINE_CLASS_WITH_WRAPPER_FIELD;
+    options[0].content.ptr = nullptr;
+    options[1].id = JSVM_DEFINE_CLASS_WITH_NATIVE_ELEMENTS;
+    options[1].content.ptr = elements;
+    JSVM_Value cls = nullptr;
+    JSVMTEST_CALL(OH_JSVM_DefineClassWithOptions(env, name, JSVM_AUTO_LENGTH, constructor, 0, nullptr, nullptr, 2,
+                                                 options, &cls));
+    jsvm::SetProperty(jsvm::Global(), name, cls);
+    return cls;
+}
+
+HWTEST_F(JSVMTest, JSVMNativeElements, TestSize.Level1)
+{
+    static std::vector<int32_t> ints = { 1, 2, 3 };
+    static std::vector<double> doubles = { 0.5, 1.5 };
+    static std::vector<uint8_t> bytes = { 0, 0 };
+    JSVM_NativeElements intElements = { JSVM_NATIVE_ELEMENT_INT32, VectorElements<int32_t>, false };
+    JSVM_NativeElements doubleElements = { JSVM_NATIVE_ELEMENT_DOUBLE, VectorElements<double>, false };
+    JSVM_NativeElements byteElements = { JSVM_NATIVE_ELEMENT_UINT8, VectorElements<uint8_t>, false };
+    static JSVM_CallbackStruct intConstructor = { WrapVector, &ints };
+    static JSVM_CallbackStruct doubleConstructor = { WrapVector, &doubles };
+    static JSVM_CallbackStruct byteConstructor = { WrapVector, &bytes };
+    DefineNativeElementsClass(env, "IntVector", &intConstructor, &intElements);
+    DefineNativeElementsClass(env, "DoubleVector", &doubleConstructor, &doubleElements);
+    DefineNativeElementsClass(env, "ByteVector", &byteConstructor, &byteElements);
+
+    jsvm::Run("var iv = new IntVector(); iv[0] = 10; iv[2] = '7.9';"
+              "var dv = new DoubleVector(); dv[1] = 2.25;"
+              "var bv = new ByteVector(); bv[0] = 257; bv[1] = -1;");
+    ASSERT_EQ(ints[0], 10);
+    ASSERT_EQ(ints[2], 7);
+    ASSERT_EQ(doubles[1], 2.25);
+    ASSERT_EQ(bytes[0], 1);
+    ASSERT_EQ(bytes[1], 255);
+
+    ints[1] = -4;
+    ASSERT_TRUE(jsvm::IsTrue(jsvm::Run("iv[1] === -4 && iv[0] + iv[2] === 17 && dv[0] === 0.5")));
+    ASSERT_TRUE(jsvm::IsTrue(jsvm::Run("1 in iv && !(3 in iv) && iv[3] === undefined")));
+    ASSERT_TRUE(jsvm::IsTrue(jsvm::Run("Object.keys(iv).join() === '0,1,2'")));
+    ASSERT_TRUE(jsvm::IsTrue(jsvm::Run("delete iv[0] === false && iv[0] === 10")));
+
+    // Indices out of range are ordinary properties.
+    jsvm::Run("iv[5] = 'x'");
+    ASSERT_EQ(ints.size(), 3u);
+    ASSERT_TRUE(jsvm::IsTrue(jsvm::Run("iv[5] === 'x'")));
+}
+
+HWTEST_F(JSVMTest, JSVMNativeElementsReadOnly, TestSize.Level1)
+{
+    static std::vector<int32_t> ints = { 1, 2 };
+    JSVM_NativeElements elements = { JSVM_NATIVE_ELEMENT_INT32, VectorElements<int32_t>, true };
+    static JSVM_CallbackStruct readOnlyConstructor = { WrapVector, &ints };
+    DefineNativeElementsClass(env, "ReadOnlyVector", &readOnlyConstructor, &elements);
+    jsvm::Run("var rv = new ReadOnlyVector(); rv[0] = 100;");
+    ASSERT_EQ(ints[0], 1);
+    ASSERT_TRUE(jsvm::IsTrue(jsvm::Run("rv[0] === 1 && !Object.getOwnPropertyDescriptor(rv, 1).writable")));
+
+    JSVM_CallbackStruct constructor = { [](JSVM_Env, JSVM_CallbackInfo) -> JSVM_Value { return nullptr; }, nullptr };
+    JSVM_NativeElements invalid = { JSVM_NATIVE_ELEMENT_INT32, nullptr, false };
+    JSVM_DefineClassOptions options[1];
+    options[0].id = JSVM_DEFINE_CLASS_WITH_NATIVE_ELEMENTS;
+    options[0].content.ptr = &invalid;
+    JSVM_Value cls = nullptr;
+    ASSERT_EQ(OH_JSVM_DefineClassWithOptions(env, "Invalid", JSVM_AUTO_LENGTH, &constructor, 0, nullptr, nullptr, 1,
+                                             options, &cls),
+              JSVM_INVALID_ARG);
+}
+
+static std::vector<int32_t> g_resizedInts;
+
+static JSVM_Value ResizeInts(JSVM_Env env, JSVM_CallbackInfo info)
+{
+    size_t argc = 1;
+    JSVM_Value argv[1] = { nullptr };
+    OH_JSVM_GetCbInfo(env, info, &argc, argv, nullptr, nullptr);
+    uint32_t size = 0;
+    OH_JSVM_GetValueUint32(env, argv[0], &size);
+    // A new vector moves the elements to a new allocation, the old one is freed.
+    std::vector<int32_t>(size, 1).swap(g_resizedInts);
+    return nullptr;
+}
+
+HWTEST_F(JSVMTest, JSVMNativeElementsResizedByValueOf, TestSize.Level1)
+{
+    g_resizedInts.assign(4, 1);
+    JSVM_NativeElements elements = { JSVM_NATIVE_ELEMENT_INT32, VectorElements<int32_t>, false };
+    static JSVM_CallbackStruct constructor = { WrapVector, &g_resizedInts };
+    DefineNativeElementsClass(env, "ResizedVector", &constructor, &elements);
+    static JSVM_CallbackStruct resize = { ResizeInts, nullptr };
+    JSVM_Value resizeFunc = nullptr;
+    JSVMTEST_CALL(OH_JSVM_CreateFunction(env, "resizeInts", JSVM_AUTO_LENGTH, &resize, &resizeFunc));
+    jsvm::SetProperty(jsvm::Global(), "resizeInts", resizeFunc);
+
+    // The array is reallocated by valueOf, the store goes to the new one.
+    jsvm::Run("var rv = new ResizedVector(); rv[3] = { valueOf() { resizeInts(8); return 7; } };");
+    ASSERT_EQ(g_resizedInts.size(), 8u);
+    ASSERT_EQ(g_resizedInts[3], 7);
+
+    // The array shrinks below the index, the store is dropped.
+    jsvm::Run("rv[5] = { valueOf() { resizeInts(2); return 9; } };");
+    ASSERT_EQ(g_resizedInts.size(), 2u);
+    ASSERT_TRUE(jsvm::IsTrue(jsvm::Run("rv[5] === undefined && !(5 in rv)")));
+
+    // A throwing conversion keeps the element.
+    jsvm::Run("try { rv[0] = { valueOf() { throw 1; } }; } catch (e) {}");
+    ASSERT_EQ(g_resizedInts[0], 1);
+}
+
+// JSVM_LAZY_DATA tests
+static int g_lazyGetterCalls = 0;
+
+static JSVM_Value LazyGetter(JSVM_Env env, JSVM_CallbackInfo info)
+{
+    g_lazyGetterCalls++;
+    JSVM_Value result = nullptr;
+    OH_JSVM_CreateInt32(env, g_lazyGetterCalls, &result);
+    return result;
+}
+
+HWTEST_F(JSVMTest, JSVMLazyDataProperty, TestSize.Level1)
+{
+    g_lazyGetterCalls = 0;
+    JSVM_CallbackStruct getter = { LazyGetter, nullptr };
+    JSVM_PropertyDescriptor descriptors[] = {
+        { "lazy", nullptr, nullptr, &getter, nullptr, nullptr,
+          static_cast<JSVM_PropertyAttributes>(JSVM_LAZY_DATA | JSVM_ENUMERABLE | JSVM_CONFIGURABLE) },
+        { "lazyWritable", nullptr, nullptr, &getter, nullptr, nullptr,
+          static_cast<JSVM_PropertyAttributes>(JSVM_LAZY_DATA | JSVM_DEFAULT_JSPROPERTY) },
+    };
+    auto obj = jsvm::Object();
+    JSVMTEST_CALL(OH_JSVM_DefineProperties(env, obj, 2, descriptors));
+    jsvm::SetProperty(jsvm::Global(), "lazyObj", obj);
+    ASSERT_EQ(g_lazyGetterCalls, 0);
+
+    ASSERT_TRUE(jsvm::IsTrue(jsvm::Run("lazyObj.lazy === 1 && lazyObj.lazy === 1")));
+    ASSERT_EQ(g_lazyGetterCalls, 1);
+    ASSERT_TRUE(jsvm::IsTrue(jsvm::Run("var d = Object.getOwnPropertyDescriptor(lazyObj, 'lazy');"
+                                       "d.value === 1 && !d.writable && d.enumerable && d.get === undefined")));
+
+    jsvm::Run("lazyObj.lazy = 5; lazyObj.lazyWritable = 7;");
+    ASSERT_EQ(g_lazyGetterCalls, 1);
+    ASSERT_TRUE(jsvm::IsTrue(jsvm::Run("lazyObj.lazy === 1 && lazyObj.lazyWritable === 7")));
+
+    JSVM_CallbackStruct setter = { LazyGetter, nullptr };
+    JSVM_PropertyDescriptor invalid = { "invalid", nullptr, nullptr, &getter, &setter, nullptr, JSVM_LAZY_DATA };
+    ASSERT_EQ(OH_JSVM_DefineProperties(env, obj, 1, &invalid), JSVM_INVALID_ARG);
+}
+
+static JSVM_Value LazyClassConstructor(JSVM_Env env, JSVM_CallbackInfo info)
+{
+    JSVM_Value thisVar = nullptr;
+    OH_JSVM_GetCbInfo(env, info, nullptr, nullptr, &thisVar, nullptr);
+    return thisVar;
+}
+
+HWTEST_F(JSVMTest, JSVMLazyDataPropertyInClass, TestSize.Level1)
+{
+    g_lazyGetterCalls = 0;
+    JSVM_CallbackStruct constructor = { LazyClassConstructor, nullptr };
+    JSVM_CallbackStruct getter = { LazyGetter, nullptr };
+    JSVM_PropertyDescriptor descriptor = { "lazy", nullptr, nullptr, &getter, nullptr, nullptr,
+                                           static_cast<JSVM_PropertyAttributes>(JSVM_LAZY_DATA | JSVM_WRITABLE) };
+    JSVM_Value cls = nullptr;
+    JSVMTEST_CALL(OH_JSVM_DefineClass(env, "LazyClass", JSVM_AUTO_LENGTH, &constructor, 1, &descriptor, &cls));
+    jsvm::SetProperty(jsvm::Global(), "LazyClass", cls);
+
+    jsvm::Run("var a = new LazyClass(); var b = new LazyClass();");
+    ASSERT_EQ(g_lazyGetterCalls, 0);
+    // Each instance computes its own value, once.
+    ASSERT_TRUE(jsvm::IsTrue(jsvm::Run("b.lazy === 1 && a.lazy === 2 && b.lazy === 1 && a.lazy === 2")));
+    ASSERT_EQ(g_lazyGetterCalls, 2);
+    ASSERT_TRUE(jsvm::IsTrue(jsvm::Run("a.hasOwnProperty('lazy') && (a.lazy = 3, a.lazy === 3)")));
+}